@@ -0,0 +1,207 @@
+#include "correlation_matrix.h"
+#include "../core/parallel.h"
+#include "../database/database_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace StockScanner {
+
+    // Tile edge in series; a TILE x TILE block of doubles (32 KB) stays resident in L1/L2
+    // while every bar of the window streams past it
+    static const size_t TILE = 64;
+
+    std::vector<double> calculateReturns(const std::vector<double>& prices) {
+        std::vector<double> returns;
+        if (prices.size() < 2) return returns;
+
+        returns.reserve(prices.size() - 1);
+        for (size_t i = 1; i < prices.size(); ++i) {
+            // A zero price has no defined return; record 0 to keep the series aligned bar for bar
+            returns.push_back(prices[i - 1] == 0.0 ? 0.0 : (prices[i] - prices[i - 1]) / prices[i - 1]);
+        }
+        return returns;
+    }
+
+    RollingCorrelationMatrix::RollingCorrelationMatrix(size_t seriesCount, size_t windowSize)
+        : seriesCount(seriesCount), windowSize(windowSize),
+          samples(seriesCount * windowSize, 0.0), oldestRow(0), updatesSinceRebuild(0),
+          shifts(seriesCount, 0.0), sums(seriesCount, 0.0), crossSums(seriesCount * seriesCount, 0.0) {
+        if (windowSize < 2) {
+            throw std::invalid_argument("Correlation window must hold at least two bars");
+        }
+    }
+
+    void RollingCorrelationMatrix::build(const std::vector<std::vector<double>>& returns) {
+        if (returns.size() != seriesCount) {
+            throw std::invalid_argument("Expected one return series per matrix column");
+        }
+
+        // Copy the window into the bar-major buffer so each bar's returns are contiguous
+        for (size_t i = 0; i < seriesCount; ++i) {
+            if (returns[i].size() < windowSize) {
+                throw std::invalid_argument("Return series is shorter than the correlation window");
+            }
+            const double* tail = returns[i].data() + (returns[i].size() - windowSize);
+            for (size_t t = 0; t < windowSize; ++t) {
+                samples[t * seriesCount + i] = tail[t];
+            }
+        }
+        oldestRow = 0;
+        rebuildSums();
+    }
+
+    void RollingCorrelationMatrix::rebuildSums() {
+        updatesSinceRebuild = 0;
+
+        // Shift every series by its current window mean so the sums stay near zero
+        const double n = static_cast<double>(windowSize);
+        std::fill(shifts.begin(), shifts.end(), 0.0);
+        for (size_t t = 0; t < windowSize; ++t) {
+            const double* bar = samples.data() + t * seriesCount;
+            for (size_t i = 0; i < seriesCount; ++i) shifts[i] += bar[i];
+        }
+        for (size_t i = 0; i < seriesCount; ++i) shifts[i] /= n;
+
+        std::fill(sums.begin(), sums.end(), 0.0);
+        for (size_t t = 0; t < windowSize; ++t) {
+            const double* bar = samples.data() + t * seriesCount;
+            for (size_t i = 0; i < seriesCount; ++i) sums[i] += bar[i] - shifts[i];
+        }
+
+        // Enumerate the tiles on and above the diagonal and hand them out to the workers
+        size_t tilesPerSide = (seriesCount + TILE - 1) / TILE;
+        std::vector<std::pair<size_t, size_t>> tiles;
+        for (size_t ti = 0; ti < tilesPerSide; ++ti) {
+            for (size_t tj = ti; tj < tilesPerSide; ++tj) {
+                tiles.emplace_back(ti, tj);
+            }
+        }
+
+        parallelFor(tiles.size(), [&](size_t tileIndex) {
+            const size_t rowBegin = tiles[tileIndex].first * TILE;
+            const size_t colBegin = tiles[tileIndex].second * TILE;
+            const size_t rows = std::min(TILE, seriesCount - rowBegin);
+            const size_t cols = std::min(TILE, seriesCount - colBegin);
+
+            std::vector<double> block(TILE * TILE, 0.0);
+            std::vector<double> colValues(cols);
+            const double* colShifts = shifts.data() + colBegin;
+            for (size_t t = 0; t < windowSize; ++t) {
+                const double* bar = samples.data() + t * seriesCount;
+                for (size_t c = 0; c < cols; ++c) {
+                    colValues[c] = bar[colBegin + c] - colShifts[c];
+                }
+                for (size_t r = 0; r < rows; ++r) {
+                    const double value = bar[rowBegin + r] - shifts[rowBegin + r];
+                    double* out = block.data() + r * TILE;
+                    for (size_t c = 0; c < cols; ++c) {
+                        out[c] += value * colValues[c];
+                    }
+                }
+            }
+
+            for (size_t r = 0; r < rows; ++r) {
+                std::copy(block.begin() + r * TILE, block.begin() + r * TILE + cols,
+                          crossSums.begin() + (rowBegin + r) * seriesCount + colBegin);
+            }
+        });
+    }
+
+    void RollingCorrelationMatrix::update(const std::vector<double>& newReturns) {
+        if (newReturns.size() != seriesCount) {
+            throw std::invalid_argument("Expected one new return per matrix column");
+        }
+
+        double* oldest = samples.data() + oldestRow * seriesCount;
+        const double* newest = newReturns.data();
+
+        // Swap the oldest bar's contribution for the newest one, one band of upper-triangle rows per task
+        parallelFor((seriesCount + TILE - 1) / TILE, [&](size_t rowTile) {
+            const size_t rowEnd = std::min(seriesCount, (rowTile + 1) * TILE);
+            for (size_t i = rowTile * TILE; i < rowEnd; ++i) {
+                const double oldValue = oldest[i] - shifts[i];
+                const double newValue = newest[i] - shifts[i];
+                double* row = crossSums.data() + i * seriesCount;
+                for (size_t j = i; j < seriesCount; ++j) {
+                    row[j] += newValue * (newest[j] - shifts[j]) - oldValue * (oldest[j] - shifts[j]);
+                }
+            }
+        });
+
+        for (size_t i = 0; i < seriesCount; ++i) {
+            sums[i] += newest[i] - oldest[i];
+            oldest[i] = newest[i];
+        }
+        oldestRow = (oldestRow + 1) % windowSize;
+
+        // Rounding error builds up with every add and subtract; recomputing once per window keeps
+        // it bounded and re-centres the shifts, at the same amortized O(N^2) cost per update
+        if (++updatesSinceRebuild == windowSize) {
+            rebuildSums();
+        }
+    }
+
+    double RollingCorrelationMatrix::crossSum(size_t i, size_t j) const {
+        if (i > j) std::swap(i, j);
+        return crossSums[i * seriesCount + j];
+    }
+
+    double RollingCorrelationMatrix::covariance(size_t i, size_t j) const {
+        if (i >= seriesCount || j >= seriesCount) {
+            throw std::out_of_range("Series index out of range");
+        }
+        const double n = static_cast<double>(windowSize);
+        return (crossSum(i, j) - sums[i] * sums[j] / n) / (n - 1.0);
+    }
+
+    double RollingCorrelationMatrix::correlation(size_t i, size_t j) const {
+        double varianceI = covariance(i, i);
+        double varianceJ = covariance(j, j);
+        if (varianceI <= 0.0 || varianceJ <= 0.0) {
+            return 0.0;
+        }
+        return covariance(i, j) / std::sqrt(varianceI * varianceJ);
+    }
+
+    std::vector<double> RollingCorrelationMatrix::covarianceMatrix() const {
+        std::vector<double> matrix(seriesCount * seriesCount);
+        for (size_t i = 0; i < seriesCount; ++i) {
+            for (size_t j = i; j < seriesCount; ++j) {
+                matrix[i * seriesCount + j] = matrix[j * seriesCount + i] = covariance(i, j);
+            }
+        }
+        return matrix;
+    }
+
+    std::vector<double> RollingCorrelationMatrix::correlationMatrix() const {
+        std::vector<double> matrix = covarianceMatrix();
+        std::vector<double> deviations(seriesCount);
+        for (size_t i = 0; i < seriesCount; ++i) {
+            deviations[i] = std::sqrt(std::max(0.0, matrix[i * seriesCount + i]));
+        }
+        for (size_t i = 0; i < seriesCount; ++i) {
+            for (size_t j = 0; j < seriesCount; ++j) {
+                double scale = deviations[i] * deviations[j];
+                double& value = matrix[i * seriesCount + j];
+                value = scale > 0.0 ? value / scale : 0.0;
+            }
+        }
+        return matrix;
+    }
+
+    RollingCorrelationMatrix loadCorrelationMatrix(const SymbolTable& symbols, const std::vector<SymbolId>& tickers,
+                                                   size_t windowSize) {
+        std::vector<std::vector<double>> prices = getAlignedStockDataFromDatabase(symbols, tickers);
+
+        std::vector<std::vector<double>> returns;
+        returns.reserve(prices.size());
+        for (const auto& series : prices) {
+            returns.push_back(calculateReturns(series));
+        }
+
+        RollingCorrelationMatrix matrix(tickers.size(), windowSize);
+        matrix.build(returns);
+        return matrix;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include "../core/symbol_table.h"
+
+namespace StockScanner {
+
+    // Converts a price series into simple returns (one fewer element than prices)
+    std::vector<double> calculateReturns(const std::vector<double>& prices);
+
+    // Pairwise covariance and correlation of N return series over a rolling window.
+    // The window is kept as a bar-major ring buffer together with per-series sums and
+    // the N x N matrix of cross-product sums, so sliding the window by one bar costs
+    // O(N^2) instead of a full O(N^2 * window) rebuild. The sums are taken over each series
+    // minus a fixed shift near its mean, which avoids cancellation in the covariance, and are
+    // recomputed from the window once every windowSize updates so rounding error cannot drift.
+    class RollingCorrelationMatrix {
+    public:
+        RollingCorrelationMatrix(size_t seriesCount, size_t windowSize);
+
+        // Rebuilds the matrix from the last windowSize returns of each series.
+        // Every series must have at least windowSize returns; throws std::invalid_argument otherwise.
+        // The cross products are computed in cache-sized tiles spread across worker threads.
+        void build(const std::vector<std::vector<double>>& returns);
+
+        // Slides the window forward by one bar, given the newest return of every series
+        void update(const std::vector<double>& newReturns);
+
+        // Sample covariance of series i and j over the window
+        double covariance(size_t i, size_t j) const;
+
+        // Pearson correlation of series i and j; 0 if either series has no variance
+        double correlation(size_t i, size_t j) const;
+
+        // Full N x N matrices in row-major order
+        std::vector<double> covarianceMatrix() const;
+        std::vector<double> correlationMatrix() const;
+
+        size_t getSeriesCount() const { return seriesCount; }
+        size_t getWindowSize() const { return windowSize; }
+
+    private:
+        size_t seriesCount;
+        size_t windowSize;
+        std::vector<double> samples;    // windowSize x seriesCount ring buffer, one row per bar
+        size_t oldestRow;               // Ring position of the oldest bar in the window
+        size_t updatesSinceRebuild;     // Incremental updates applied since the sums were last recomputed
+        std::vector<double> shifts;     // Per-series value subtracted before summing; the window mean at the last rebuild
+        std::vector<double> sums;       // Per-series sum of shifted returns over the window
+        std::vector<double> crossSums;  // Sums of shifted products; only the upper triangle (i <= j) is maintained
+
+        // Recomputes shifts, sums and crossSums from the samples in the window
+        void rebuildSums();
+        double crossSum(size_t i, size_t j) const;
+    };
+
+    // Loads the aligned close prices of the interned tickers from the database and builds their
+    // rolling correlation matrix over the most recent windowSize returns; row i is tickers[i]
+    RollingCorrelationMatrix loadCorrelationMatrix(const SymbolTable& symbols, const std::vector<SymbolId>& tickers,
+                                                   size_t windowSize);
+}
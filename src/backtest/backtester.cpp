@@ -0,0 +1,117 @@
+#include "backtester.h"
+#include "../core/parallel.h"
+#include "../database/database_utils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace StockScanner {
+
+    // Signal state for one series, updated one bar at a time. The window checks are
+    // kept incremental so each bar costs O(1) regardless of the window size:
+    // the threshold compares the bar leaving the window with the newest one, and
+    // momentum tracks how many consecutive moves have been up.
+    class SignalReplay {
+    public:
+        SignalReplay(const std::vector<double>& prices, const BacktestParameters& parameters)
+            : prices(prices), parameters(parameters), upMoves(0) {}
+
+        struct Signals {
+            bool threshold;
+            bool momentum;
+        };
+
+        // Delivers bar `bar` of the series and reports which signals fired on it
+        Signals onBar(size_t bar) {
+            if (bar > 0) {
+                upMoves = prices[bar - 1] < prices[bar] ? upMoves + 1 : 0;
+            }
+
+            Signals signals{false, false};
+            const size_t window = parameters.windowSize;
+            if (window == 0 || bar + 1 < window) {
+                return signals;  // Not enough bars for a full window yet
+            }
+
+            // Same test as checkThreshold on the window
+            if (window >= 2) {
+                double first = prices[bar + 1 - window];
+                double percentChange = ((prices[bar] - first) / first) * 100;
+                signals.threshold = std::abs(percentChange) >= parameters.threshold;
+            }
+
+            // Same test as detectMomentum on the window: every move inside it was up
+            signals.momentum = upMoves + 1 >= window;
+            return signals;
+        }
+
+    private:
+        const std::vector<double>& prices;
+        const BacktestParameters& parameters;
+        size_t upMoves;
+    };
+
+    BacktestResult runBacktest(const std::vector<std::vector<double>>& universe,
+                               const BacktestParameters& parameters, size_t holdingPeriod) {
+        BacktestResult result;
+        result.parameters = parameters;
+        const size_t holding = std::max<size_t>(holdingPeriod, 1);
+
+        double totalReturn = 0.0;
+        for (SymbolId symbol = 0; symbol < universe.size(); ++symbol) {
+            const std::vector<double>& prices = universe[symbol];
+            SignalReplay replay(prices, parameters);
+
+            size_t openUntil = 0;  // Bar at which the open position exits; 0 when flat
+            size_t entryBar = 0;
+            for (size_t bar = 0; bar < prices.size(); ++bar) {
+                SignalReplay::Signals signals = replay.onBar(bar);
+                result.thresholdHits += signals.threshold;
+                result.momentumHits += signals.momentum;
+
+                if (openUntil != 0 && bar == openUntil) {
+                    BacktestTrade trade{symbol, entryBar, bar, prices[entryBar], prices[bar], 0.0};
+                    trade.returnPercent = (trade.exitPrice - trade.entryPrice) / trade.entryPrice * 100;
+                    result.wins += trade.returnPercent > 0.0;
+                    totalReturn += trade.returnPercent;
+                    result.trades.push_back(trade);
+                    openUntil = 0;
+                }
+
+                if (openUntil == 0 && signals.threshold && signals.momentum && bar + holding < prices.size()) {
+                    entryBar = bar;
+                    openUntil = bar + holding;
+                }
+            }
+            result.barsReplayed += prices.size();
+        }
+
+        if (!result.trades.empty()) {
+            result.averageReturnPercent = totalReturn / static_cast<double>(result.trades.size());
+        }
+        return result;
+    }
+
+    std::vector<BacktestResult> runParameterSweep(const std::vector<std::vector<double>>& universe,
+                                                  const std::vector<double>& thresholds,
+                                                  const std::vector<size_t>& windowSizes,
+                                                  size_t holdingPeriod) {
+        std::vector<BacktestResult> results(thresholds.size() * windowSizes.size());
+
+        // Each grid point is an independent task over the shared, read-only universe
+        parallelFor(results.size(), [&](size_t index) {
+            BacktestParameters parameters{thresholds[index / windowSizes.size()], windowSizes[index % windowSizes.size()]};
+            results[index] = runBacktest(universe, parameters, holdingPeriod);
+        });
+
+        return results;
+    }
+
+    std::vector<std::vector<double>> loadBacktestUniverse(const SymbolTable& symbols,
+                                                          const std::vector<SymbolId>& tickers) {
+        std::vector<std::vector<double>> universe(symbols.size());
+        for (SymbolId ticker : tickers) {
+            universe[ticker] = getStockDataFromDatabase(symbols, ticker);
+        }
+        return universe;
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include "../core/symbol_table.h"
+
+namespace StockScanner {
+
+    // One point of the (threshold, windowSize) grid
+    struct BacktestParameters {
+        double threshold;   // Minimum absolute percent move across the window
+        size_t windowSize;  // Number of bars in the sliding window
+    };
+
+    // A position opened when both signals fired and closed after the holding period
+    struct BacktestTrade {
+        SymbolId symbol;
+        size_t entryBar;
+        size_t exitBar;
+        double entryPrice;
+        double exitPrice;
+        double returnPercent;
+    };
+
+    struct BacktestResult {
+        BacktestParameters parameters;
+        size_t barsReplayed = 0;
+        size_t thresholdHits = 0;   // Bars whose window met the threshold
+        size_t momentumHits = 0;    // Bars whose window rose on every move
+        size_t wins = 0;            // Trades with a positive return
+        double averageReturnPercent = 0.0;
+        std::vector<BacktestTrade> trades;
+    };
+
+    // Replays every bar of each series in order through the same checks as
+    // checkThreshold and detectMomentum on a window of parameters.windowSize bars.
+    // universe holds one series per SymbolId, empty for symbols that were not loaded.
+    // When both fire and no position is open, a long position is entered at that
+    // bar's close and exited holdingPeriod bars later (at least one).
+    BacktestResult runBacktest(const std::vector<std::vector<double>>& universe,
+                               const BacktestParameters& parameters, size_t holdingPeriod);
+
+    // Runs every combination of thresholds and window sizes in parallel. All runs
+    // read the same loaded series; results are ordered thresholds-major.
+    std::vector<BacktestResult> runParameterSweep(const std::vector<std::vector<double>>& universe,
+                                                  const std::vector<double>& thresholds,
+                                                  const std::vector<size_t>& windowSizes,
+                                                  size_t holdingPeriod);
+
+    // Loads the stored close prices of each interned ticker for a sweep, indexed by SymbolId
+    std::vector<std::vector<double>> loadBacktestUniverse(const SymbolTable& symbols,
+                                                          const std::vector<SymbolId>& tickers);
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include "order_statistic_tree.h"
+
+// Node of a BalancedBinaryTree
+template <typename T>
+struct BalancedBinaryTreeNode {
+    T data;
+    size_t count;   // Copies of data held by this node
+    size_t size;    // Copies held by this node and all of its descendants
+    int height;     // Levels in the subtree rooted here; 1 for a leaf
+    BalancedBinaryTreeNode* left;
+    BalancedBinaryTreeNode* right;
+
+    explicit BalancedBinaryTreeNode(const T& value) : data(value), count(1), size(1), height(1), left(nullptr), right(nullptr) {}
+};
+
+// AVL tree with the same interface as BinaryTree, including subtree sizes for rank and select.
+// Every node keeps the height of its subtree, and the two subtrees of any node differ in height
+// by at most one, so the height stays below 1.45 log2(n) even for sorted input such as
+// timestamps or prices in arrival order. Add, Remove and Find are iterative: updates record the
+// links they pass through in a fixed-size array and rebalance bottom-up along it.
+// Duplicate values are ignored unless AllowDuplicates is true, and Pooled takes nodes from an
+// owned NodePool as in BinaryTree; the queries and iteration come from OrderStatisticTree.
+template <typename T = int, bool AllowDuplicates = false, bool Pooled = false>
+class BalancedBinaryTree : public OrderStatisticTree<BalancedBinaryTreeNode<T>, T, Pooled> {
+private:
+    using Node = BalancedBinaryTreeNode<T>;
+    using Base = OrderStatisticTree<Node, T, Pooled>;
+    using Base::root;
+    using Base::sizeOf;
+    using Base::newNode;
+    using Base::freeNode;
+
+    // An AVL tree of height h holds at least Fib(h + 2) - 1 nodes, so no tree addressable
+    // with 64 bits is taller than this
+    static constexpr size_t MAX_HEIGHT = 96;
+
+    static int heightOf(const Node* node) { return node ? node->height : 0; }
+    static int balanceOf(const Node* node) { return heightOf(node->left) - heightOf(node->right); }
+
+    // Recomputes a node's height and size from its children
+    static void update(Node* node) {
+        node->height = 1 + std::max(heightOf(node->left), heightOf(node->right));
+        node->size = node->count + sizeOf(node->left) + sizeOf(node->right);
+    }
+
+    static Node* rotateRight(Node* node) {
+        Node* pivot = node->left;
+        node->left = pivot->right;
+        pivot->right = node;
+        update(node);
+        update(pivot);
+        return pivot;
+    }
+
+    static Node* rotateLeft(Node* node) {
+        Node* pivot = node->right;
+        node->right = pivot->left;
+        pivot->left = node;
+        update(node);
+        update(pivot);
+        return pivot;
+    }
+
+    // Updates a node whose subtrees changed and restores the AVL condition, returning the new subtree root
+    static Node* rebalance(Node* node) {
+        update(node);
+        int balance = balanceOf(node);
+        if (balance > 1) {
+            if (balanceOf(node->left) < 0) node->left = rotateLeft(node->left);
+            return rotateRight(node);
+        }
+        if (balance < -1) {
+            if (balanceOf(node->right) > 0) node->right = rotateRight(node->right);
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    // Rebalances every node on a recorded path, deepest first
+    static void rebalancePath(Node** path[], size_t depth) {
+        while (depth > 0) {
+            Node** link = path[--depth];
+            *link = rebalance(*link);
+        }
+    }
+
+    bool isBalancedHelper(const Node* node) const;
+
+public:
+    // Functions
+    void Add(const T& value);
+    void Remove(const T& value);    // Removes one copy of value, if present
+    int Height() const { return heightOf(root); }
+    bool isBalanced() const;    // Stored heights and the AVL condition at every node
+};
+
+// Add a value, then rebalance the nodes on the path back up to the root
+template <typename T, bool AllowDuplicates, bool Pooled>
+void BalancedBinaryTree<T, AllowDuplicates, Pooled>::Add(const T& value) {
+    Node** path[MAX_HEIGHT];
+    size_t depth = 0;
+    Node** link = &root;
+
+    while (*link) {
+        Node* node = *link;
+        path[depth++] = link;
+        if (value < node->data) {
+            link = &node->left;
+        } else if (node->data < value) {
+            link = &node->right;
+        } else {
+            if (!AllowDuplicates) return;   // Already present; nothing changes
+            ++node->count;                  // Another copy of an existing value
+            rebalancePath(path, depth);     // Only sizes change, so this just updates them
+            return;
+        }
+    }
+
+    *link = newNode(value);
+    rebalancePath(path, depth);
+}
+
+// Remove one copy of a value. A node with two children takes the value of its in-order
+// successor, whose node (which has no left child) is unlinked instead.
+template <typename T, bool AllowDuplicates, bool Pooled>
+void BalancedBinaryTree<T, AllowDuplicates, Pooled>::Remove(const T& value) {
+    Node** path[MAX_HEIGHT];
+    size_t depth = 0;
+    Node** link = &root;
+
+    while (*link && (value < (*link)->data || (*link)->data < value)) {
+        path[depth++] = link;
+        link = value < (*link)->data ? &(*link)->left : &(*link)->right;
+    }
+    Node* node = *link;
+    if (!node) return; // Value not found
+
+    if (node->count > 1) {
+        --node->count;  // Drop one copy and keep the node
+        path[depth++] = link;
+        rebalancePath(path, depth);
+        return;
+    }
+
+    if (node->left && node->right) {
+        path[depth++] = link;
+        Node** successorLink = &node->right;
+        while ((*successorLink)->left) {
+            path[depth++] = successorLink;
+            successorLink = &(*successorLink)->left;
+        }
+        Node* successor = *successorLink;
+        node->data = successor->data;
+        node->count = successor->count;
+        *successorLink = successor->right;
+        freeNode(successor);
+    } else {
+        *link = node->left ? node->left : node->right;
+        freeNode(node);
+    }
+    rebalancePath(path, depth);
+}
+
+// Checks that every stored height is correct and no node's subtrees differ in height by more than one
+template <typename T, bool AllowDuplicates, bool Pooled>
+bool BalancedBinaryTree<T, AllowDuplicates, Pooled>::isBalanced() const {
+    return isBalancedHelper(root);
+}
+
+template <typename T, bool AllowDuplicates, bool Pooled>
+bool BalancedBinaryTree<T, AllowDuplicates, Pooled>::isBalancedHelper(const Node* node) const {
+    if (!node) return true;
+    if (node->height != 1 + std::max(heightOf(node->left), heightOf(node->right))) return false;
+    int balance = balanceOf(node);
+    if (balance < -1 || balance > 1) return false;
+    return isBalancedHelper(node->left) && isBalancedHelper(node->right);
+}
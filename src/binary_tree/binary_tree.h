@@ -1,40 +1,128 @@
 #pragma once
 
-#include <iostream>
-#include <optional>
+#include "order_statistic_tree.h"
 
-class Node {
-public:
-    int data;
-    Node* left;
-    Node* right;
+// Node of a BinaryTree
+template <typename T>
+struct BinaryTreeNode {
+    T data;
+    size_t count;   // Copies of data held by this node
+    size_t size;    // Copies held by this node and all of its descendants
+    BinaryTreeNode* left;
+    BinaryTreeNode* right;
 
-    Node(int value) : data(value), left(nullptr), right(nullptr) {}
+    explicit BinaryTreeNode(const T& value) : data(value), count(1), size(1), left(nullptr), right(nullptr) {}
 };
 
-class BinaryTree {
+// Binary search tree augmented with subtree sizes (an order-statistic tree).
+// Every node stores one distinct value together with how many copies of it were
+// added, so rank and select queries run in time proportional to the tree height.
+// Duplicate values are ignored unless AllowDuplicates is true, and Pooled takes nodes from an
+// owned NodePool (see OrderStatisticTree, which provides the queries and iteration).
+template <typename T = int, bool AllowDuplicates = false, bool Pooled = false>
+class BinaryTree : public OrderStatisticTree<BinaryTreeNode<T>, T, Pooled> {
 private:
-    Node* root;
+    using Node = BinaryTreeNode<T>;
+    using Base = OrderStatisticTree<Node, T, Pooled>;
+    using Base::root;
+    using Base::sizeOf;
+    using Base::newNode;
+    using Base::freeNode;
 
     // Helper functions
-    Node* addHelper(Node* node, int value);
-    Node* removeHelper(Node* node, int value);
-    Node* findMin(Node* node);
-    Node* findHelper(Node* node, int value) const;
-    void inorderTraverseHelper(Node* node) const;
-    bool isValidBSTHelper(Node* node, int min, int max) const;
+    Node* addHelper(Node* node, const T& value, bool& inserted);
+    Node* removeHelper(Node* node, const T& value);
+    Node* detachMin(Node* node, Node*& minNode);
 
 public:
-    // Constructor and Destructor
-    BinaryTree();
-    ~BinaryTree();
-    void clear(Node* node);
-
     // Functions
-    void Add(int value);
-    void Remove(int value);
-    int Maximum() const;
-    bool Find(int value) const;
-    void InorderTraverse() const;
-    bool isValidBST() const;
+    void Add(const T& value);
+    void Remove(const T& value);    // Removes one copy of value, if present
 };
+
+// Add a value to the BST
+template <typename T, bool AllowDuplicates, bool Pooled>
+void BinaryTree<T, AllowDuplicates, Pooled>::Add(const T& value) {
+    bool inserted = false;
+    root = addHelper(root, value, inserted);
+}
+
+// Helper function for Add - recursively finds the correct location and inserts the new node,
+// growing the subtree sizes along the path when a copy was actually added
+template <typename T, bool AllowDuplicates, bool Pooled>
+typename BinaryTree<T, AllowDuplicates, Pooled>::Node* BinaryTree<T, AllowDuplicates, Pooled>::addHelper(Node* node, const T& value, bool& inserted) {
+    if (!node) {
+        inserted = true;
+        return newNode(value);
+    }
+
+    if (value < node->data) {
+        node->left = addHelper(node->left, value, inserted);   // Search left subtree
+    } else if (node->data < value) {
+        node->right = addHelper(node->right, value, inserted); // Search right subtree
+    } else if (AllowDuplicates) {
+        ++node->count;                                          // Another copy of an existing value
+        inserted = true;
+    }
+
+    if (inserted) {
+        ++node->size;
+    }
+    return node;
+}
+
+// Remove a value from the BST
+template <typename T, bool AllowDuplicates, bool Pooled>
+void BinaryTree<T, AllowDuplicates, Pooled>::Remove(const T& value) {
+    if (!this->Find(value)) return; // Value not found, so no subtree sizes change
+    root = removeHelper(root, value);
+}
+
+// Helper function for Remove - recursively finds the node holding the value and removes one copy.
+// The value is known to be present, so every node on the path loses exactly one from its size.
+template <typename T, bool AllowDuplicates, bool Pooled>
+typename BinaryTree<T, AllowDuplicates, Pooled>::Node* BinaryTree<T, AllowDuplicates, Pooled>::removeHelper(Node* node, const T& value) {
+    if (value < node->data) {
+        node->left = removeHelper(node->left, value);   // Search left subtree
+    } else if (node->data < value) {
+        node->right = removeHelper(node->right, value); // Search right subtree
+    } else if (node->count > 1) {
+        --node->count;                                  // Drop one copy and keep the node
+    } else {
+        // Node found
+        if (!node->left) { // Case: No left child
+            Node* temp = node->right;
+            freeNode(node);
+            return temp;
+        } else if (!node->right) { // Case: No right child
+            Node* temp = node->left;
+            freeNode(node);
+            return temp;
+        }
+
+        // Case: Two children
+        // Replace with the inorder successor (smallest in the right subtree)
+        Node* successor = nullptr;
+        Node* right = detachMin(node->right, successor);
+        successor->left = node->left;
+        successor->right = right;
+        successor->size = successor->count + sizeOf(successor->left) + sizeOf(successor->right);
+        freeNode(node);
+        return successor;
+    }
+
+    --node->size;
+    return node; // Return the updated node
+}
+
+// Unlinks the minimum node of a subtree, returning the new subtree root and the detached node
+template <typename T, bool AllowDuplicates, bool Pooled>
+typename BinaryTree<T, AllowDuplicates, Pooled>::Node* BinaryTree<T, AllowDuplicates, Pooled>::detachMin(Node* node, Node*& minNode) {
+    if (!node->left) {
+        minNode = node;
+        return node->right;
+    }
+    node->left = detachMin(node->left, minNode);
+    node->size -= minNode->count;
+    return node;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include "../memory/node_pool.h"
+#include "tree_traversal.h"
+
+// Storage, queries and iteration shared by BinaryTree and BalancedBinaryTree, which differ only in
+// how Add and Remove reshape the tree. Node needs the data, count, size, left and right members
+// described in tree_traversal.h. When Pooled is true the nodes come from a NodePool owned by the
+// tree, so adds and removes skip the general heap and clearing a tree of trivially destructible
+// values is a single pool reset rather than one delete per node.
+template <typename Node, typename T, bool Pooled>
+class OrderStatisticTree {
+public:
+    // Bidirectional in-order iterator; a value added several times is visited once per copy
+    using const_iterator = TreeIterator<Node, T>;
+
+    OrderStatisticTree(const OrderStatisticTree&) = delete;
+    OrderStatisticTree& operator=(const OrderStatisticTree&) = delete;
+
+    // Removes every value from the tree
+    void clear();
+
+    // Functions
+    T Maximum() const;
+    T Minimum() const;
+    bool Find(const T& value) const { return findTreeNode(root, value) != nullptr; }
+    size_t Count(const T& value) const;
+    size_t Size() const { return sizeOf(root); }
+    void InorderTraverse() const;
+    bool isValidBST() const { return isValidSearchTree(root); }    // Ordering and subtree sizes
+
+    // Order statistics
+    size_t Rank(const T& value) const { return countTreeBelow<false>(root, value); }  // Number of stored values less than value
+    T Select(size_t k) const;           // k-th smallest stored value (0-based)
+
+    // Iteration in ascending order
+    const_iterator begin() const { return const_iterator::first(root); }
+    const_iterator end() const { return const_iterator::last(root); }
+    const_iterator lower_bound(const T& value) const { return const_iterator::template bound<false>(root, value); }
+    const_iterator upper_bound(const T& value) const { return const_iterator::template bound<true>(root, value); }
+
+    // Range queries over the closed interval [low, high]
+    size_t RangeCount(const T& low, const T& high) const;
+    template <typename Visitor>
+    void RangeVisit(const T& low, const T& high, Visitor visitor) const;
+
+protected:
+    Node* root;
+    NodePool<Node> pool;    // Node storage when Pooled; unused otherwise
+
+    OrderStatisticTree() : root(nullptr) {}
+    ~OrderStatisticTree() { clear(); }
+
+    static size_t sizeOf(const Node* node) { return node ? node->size : 0; }
+    Node* newNode(const T& value);
+    void freeNode(Node* node);
+};
+
+// Removes every value from the tree
+template <typename Node, typename T, bool Pooled>
+void OrderStatisticTree<Node, T, Pooled>::clear() {
+    if constexpr (Pooled && std::is_trivially_destructible_v<T>) {
+        pool.reset();       // No destructors to run, so drop every node at once
+    } else {
+        destroyTree(root, [this](Node* node) { freeNode(node); });
+        if constexpr (Pooled) pool.reset();
+    }
+    root = nullptr;
+}
+
+// Allocates a node from the pool or the heap
+template <typename Node, typename T, bool Pooled>
+Node* OrderStatisticTree<Node, T, Pooled>::newNode(const T& value) {
+    if constexpr (Pooled) {
+        return pool.allocate(value);
+    } else {
+        return new Node(value);
+    }
+}
+
+// Frees a node allocated by newNode
+template <typename Node, typename T, bool Pooled>
+void OrderStatisticTree<Node, T, Pooled>::freeNode(Node* node) {
+    if constexpr (Pooled) {
+        pool.deallocate(node);
+    } else {
+        delete node;
+    }
+}
+
+// Find the maximum value in the tree
+template <typename Node, typename T, bool Pooled>
+T OrderStatisticTree<Node, T, Pooled>::Maximum() const {
+    if (!root) {
+        std::cerr << "Maximum called on empty tree!" << std::endl;
+        throw std::out_of_range("Tree is empty");
+    }
+    const Node* current = root;
+    while (current->right) {
+        current = current->right;
+    }
+    return current->data;
+}
+
+// Find the minimum value in the tree
+template <typename Node, typename T, bool Pooled>
+T OrderStatisticTree<Node, T, Pooled>::Minimum() const {
+    if (!root) {
+        std::cerr << "Minimum called on empty tree!" << std::endl;
+        throw std::out_of_range("Tree is empty");
+    }
+    const Node* current = root;
+    while (current->left) {
+        current = current->left;
+    }
+    return current->data;
+}
+
+// Number of copies of a value held by the tree
+template <typename Node, typename T, bool Pooled>
+size_t OrderStatisticTree<Node, T, Pooled>::Count(const T& value) const {
+    const Node* node = findTreeNode(root, value);
+    return node ? node->count : 0;
+}
+
+// Return the k-th smallest stored value (0-based), counting duplicate copies individually
+template <typename Node, typename T, bool Pooled>
+T OrderStatisticTree<Node, T, Pooled>::Select(size_t k) const {
+    if (k >= Size()) {
+        throw std::out_of_range("Select index out of range");
+    }
+    return selectTreeNode(root, k)->data;
+}
+
+// Count the stored values between low and high inclusive from two root-to-leaf rank walks
+template <typename Node, typename T, bool Pooled>
+size_t OrderStatisticTree<Node, T, Pooled>::RangeCount(const T& low, const T& high) const {
+    if (high < low) return 0;
+    return countTreeBelow<true>(root, high) - countTreeBelow<false>(root, low);
+}
+
+// Call visitor(value) for every stored copy between low and high inclusive, in ascending order,
+// without recursion
+template <typename Node, typename T, bool Pooled>
+template <typename Visitor>
+void OrderStatisticTree<Node, T, Pooled>::RangeVisit(const T& low, const T& high, Visitor visitor) const {
+    if (high < low) return;
+    visitTreeRange(root, low, high, visitor);
+}
+
+// Print the contents of the tree in ascending order
+template <typename Node, typename T, bool Pooled>
+void OrderStatisticTree<Node, T, Pooled>::InorderTraverse() const {
+    for (const T& value : *this) {
+        std::cout << value << " ";
+    }
+    std::cout << std::endl;
+}
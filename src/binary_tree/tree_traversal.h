@@ -0,0 +1,244 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+// Non-recursive traversal shared by BinaryTree and BalancedBinaryTree. Everything here works on
+// any search tree node with data, count, size, left and right members, where count is the number
+// of copies of data held by the node and size is the number of copies in its subtree.
+
+// Bidirectional in-order iterator. Nodes have no parent links, so the iterator keeps the path from
+// the root to its current node on a stack of its own; each step moves along that path and costs
+// amortized O(1). Values added more than once are visited once per copy. Any change to the tree
+// invalidates every iterator.
+template <typename Node, typename T>
+class TreeIterator {
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    TreeIterator() : root(nullptr), copy(0) {}
+
+    reference operator*() const { return path.back()->data; }
+    pointer operator->() const { return &path.back()->data; }
+
+    TreeIterator& operator++() {
+        if (++copy < path.back()->count) return *this;
+        copy = 0;
+        const Node* node = path.back();
+        if (node->right) {
+            descendLeft(node->right);
+        } else {
+            // Climb until we leave a left subtree; its parent is the next node
+            const Node* child;
+            do {
+                child = path.back();
+                path.pop_back();
+            } while (!path.empty() && path.back()->right == child);
+        }
+        return *this;
+    }
+
+    TreeIterator& operator--() {
+        if (path.empty()) {
+            if (root) descendRight(root);   // Stepping back from end() reaches the maximum
+        } else if (copy > 0) {
+            --copy;
+            return *this;
+        } else if (path.back()->left) {
+            descendRight(path.back()->left);
+        } else {
+            const Node* child;
+            do {
+                child = path.back();
+                path.pop_back();
+            } while (!path.empty() && path.back()->left == child);
+        }
+        copy = path.empty() ? 0 : path.back()->count - 1;
+        return *this;
+    }
+
+    TreeIterator operator++(int) {
+        TreeIterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    TreeIterator operator--(int) {
+        TreeIterator previous = *this;
+        --*this;
+        return previous;
+    }
+
+    bool operator==(const TreeIterator& other) const { return current() == other.current() && copy == other.copy; }
+    bool operator!=(const TreeIterator& other) const { return !(*this == other); }
+
+    // Iterator at the smallest value of the tree
+    static TreeIterator first(const Node* root) {
+        TreeIterator it(root);
+        if (root) it.descendLeft(root);
+        return it;
+    }
+
+    // Iterator one past the largest value
+    static TreeIterator last(const Node* root) {
+        return TreeIterator(root);
+    }
+
+    // Iterator at the first copy of the smallest value not less than value, or, when Strict, the
+    // smallest value greater than it
+    template <bool Strict>
+    static TreeIterator bound(const Node* root, const T& value) {
+        TreeIterator it(root);
+        size_t keep = 0;    // Length of the path up to the best candidate so far
+        for (const Node* node = root; node;) {
+            it.path.push_back(node);
+            bool goesLeft = Strict ? value < node->data : !(node->data < value);
+            if (goesLeft) {
+                keep = it.path.size();
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+        it.path.resize(keep);
+        return it;
+    }
+
+private:
+    const Node* root;
+    std::vector<const Node*> path;  // Root to current node; empty at end()
+    size_t copy;                    // Which copy of the current node's value
+
+    explicit TreeIterator(const Node* root) : root(root), copy(0) {}
+
+    const Node* current() const { return path.empty() ? nullptr : path.back(); }
+
+    void descendLeft(const Node* node) {
+        for (; node; node = node->left) path.push_back(node);
+    }
+
+    void descendRight(const Node* node) {
+        for (; node; node = node->right) path.push_back(node);
+    }
+};
+
+// Calls visitor(value) once per stored copy of every value in [low, high], in ascending order.
+// Subtrees entirely below low are never entered, so this costs O(height + k) for k results.
+template <typename Node, typename T, typename Visitor>
+void visitTreeRange(const Node* root, const T& low, const T& high, Visitor& visitor) {
+    std::vector<const Node*> stack;
+    const Node* node = root;
+    while (node || !stack.empty()) {
+        while (node) {
+            if (node->data < low) {
+                node = node->right;     // This node and its left subtree are below the range
+            } else {
+                stack.push_back(node);
+                node = node->left;
+            }
+        }
+        node = stack.back();
+        stack.pop_back();
+        if (high < node->data) return;
+        for (size_t i = 0; i < node->count; ++i) {
+            visitor(node->data);
+        }
+        node = node->right;
+    }
+}
+
+// Node holding value, or nullptr, found along a single root-to-leaf path
+template <typename Node, typename T>
+const Node* findTreeNode(const Node* node, const T& value) {
+    while (node) {
+        if (value < node->data) {
+            node = node->left;
+        } else if (node->data < value) {
+            node = node->right;
+        } else {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+// Node holding the k-th smallest stored copy (0-based), counting duplicate copies individually and
+// steering by the subtree sizes; k must be less than the size of the tree
+template <typename Node>
+const Node* selectTreeNode(const Node* node, size_t k) {
+    while (true) {
+        size_t leftSize = node->left ? node->left->size : 0;
+        if (k < leftSize) {
+            node = node->left;
+        } else if (k < leftSize + node->count) {
+            return node;
+        } else {
+            k -= leftSize + node->count;
+            node = node->right;
+        }
+    }
+}
+
+// Number of stored copies less than value (or not greater than it, when Inclusive), found along a
+// single root-to-leaf path from the subtree sizes
+template <bool Inclusive, typename Node, typename T>
+size_t countTreeBelow(const Node* node, const T& value) {
+    size_t count = 0;
+    while (node) {
+        if (value < node->data) {
+            node = node->left;
+        } else if (node->data < value) {
+            count += (node->left ? node->left->size : 0) + node->count;
+            node = node->right;
+        } else {
+            return count + (node->left ? node->left->size : 0) + (Inclusive ? node->count : 0);
+        }
+    }
+    return count;
+}
+
+// Frees every node of a tree with freeNode(node) in O(n) time and O(1) space: while the current
+// node has a left child, a right rotation lifts that child above it, so nodes are freed in order
+template <typename Node, typename FreeNode>
+void destroyTree(Node* node, FreeNode freeNode) {
+    while (node) {
+        if (node->left) {
+            Node* left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        } else {
+            Node* right = node->right;
+            freeNode(node);
+            node = right;
+        }
+    }
+}
+
+// Checks that an in-order walk sees strictly increasing values and that every node's size equals
+// its count plus its children's sizes, using an explicit stack instead of recursion
+template <typename Node>
+bool isValidSearchTree(const Node* root) {
+    std::vector<const Node*> stack;
+    const Node* previous = nullptr;
+    const Node* node = root;
+    while (node || !stack.empty()) {
+        while (node) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        if (previous && !(previous->data < node->data)) return false;
+        size_t expectedSize = node->count + (node->left ? node->left->size : 0) + (node->right ? node->right->size : 0);
+        if (node->count == 0 || node->size != expectedSize) return false;
+        previous = node;
+        node = node->right;
+    }
+    return true;
+}
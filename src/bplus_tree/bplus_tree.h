@@ -0,0 +1,520 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// In-memory B+ tree for ordered keys such as bar timestamps. Nodes are NodeBytes wide (a few
+// cache lines by default) and keep their keys in one contiguous array, so a lookup touches a
+// handful of nodes and scans each with sequential reads instead of chasing one pointer per level.
+// Values live only in the leaves, which are linked left to right so a range scan walks them
+// without going back up the tree.
+//
+// Inserts of a key larger than every stored key (the common case for arriving bars) go straight
+// to the rightmost leaf without a descent, and a full node on the right edge is split by starting
+// a new empty node instead of halving it, so appended data packs nodes completely. bulkLoad builds
+// the tree bottom-up from sorted input in linear time. There is no removal; rebuild with bulkLoad
+// to drop old entries.
+template <typename KeyType = int64_t, typename ValueType = uint32_t, size_t NodeBytes = 512>
+class BPlusTree {
+private:
+    struct Node {
+        uint32_t count; // Keys in use
+        bool leaf;
+    };
+
+public:
+    // Entries per node that fit in NodeBytes alongside the header and the link or extra child
+    static constexpr size_t LEAF_CAPACITY = (NodeBytes - sizeof(Node) - sizeof(void*)) / (sizeof(KeyType) + sizeof(ValueType));
+    static constexpr size_t INNER_CAPACITY = (NodeBytes - sizeof(Node) - sizeof(void*)) / (sizeof(KeyType) + sizeof(void*));
+    static_assert(LEAF_CAPACITY >= 3 && INNER_CAPACITY >= 3, "NodeBytes is too small for the key and value types");
+
+private:
+    // Nodes start on a cache line so a node of NodeBytes spans exactly NodeBytes / 64 lines
+    struct alignas(64) Leaf : Node {
+        KeyType keys[LEAF_CAPACITY];
+        ValueType values[LEAF_CAPACITY];
+        Leaf* next;     // Leaf holding the following keys, or nullptr for the last leaf
+    };
+
+    // children[i] holds the keys below keys[i]; children[count] holds the rest
+    struct alignas(64) Inner : Node {
+        KeyType keys[INNER_CAPACITY];
+        Node* children[INNER_CAPACITY + 1];
+    };
+
+    static_assert(NodeBytes % 64 == 0, "NodeBytes must be a whole number of cache lines");
+    static_assert(sizeof(Leaf) <= NodeBytes && sizeof(Inner) <= NodeBytes, "Nodes must fit in NodeBytes");
+
+    static constexpr size_t MAX_HEIGHT = 64;
+
+    Node* root;
+    Leaf* first;    // Leftmost leaf, where iteration starts
+    Leaf* last;     // Rightmost leaf, target of the append fast path
+    size_t size;
+    size_t height;  // Levels including the leaves; 0 when empty
+
+    static Leaf* newLeaf() {
+        Leaf* leaf = new Leaf;
+        leaf->count = 0;
+        leaf->leaf = true;
+        leaf->next = nullptr;
+        return leaf;
+    }
+
+    static Inner* newInner() {
+        Inner* inner = new Inner;
+        inner->count = 0;
+        inner->leaf = false;
+        return inner;
+    }
+
+    // Frees a chain of leaves not yet attached to any inner node
+    static void destroyLeaves(Leaf* leaf) {
+        while (leaf) {
+            Leaf* next = leaf->next;
+            delete leaf;
+            leaf = next;
+        }
+    }
+
+    static void destroy(Node* node) {
+        if (!node) return;
+        if (node->leaf) {
+            delete static_cast<Leaf*>(node);
+        } else {
+            Inner* inner = static_cast<Inner*>(node);
+            for (uint32_t i = 0; i <= inner->count; ++i) {
+                destroy(inner->children[i]);
+            }
+            delete inner;
+        }
+    }
+
+    // Child index to follow for key: the number of separators not greater than it
+    static uint32_t childIndex(const Inner* inner, const KeyType& key) {
+        return static_cast<uint32_t>(std::upper_bound(inner->keys, inner->keys + inner->count, key) - inner->keys);
+    }
+
+    const Leaf* findLeaf(const KeyType& key) const {
+        const Node* node = root;
+        while (!node->leaf) {
+            const Inner* inner = static_cast<const Inner*>(node);
+            node = inner->children[childIndex(inner, key)];
+        }
+        return static_cast<const Leaf*>(node);
+    }
+
+    // Adds a new root above the old one, with the old root and sibling as its two children
+    void growRoot(Node* sibling, const KeyType& separator) {
+        Inner* newRoot = newInner();
+        newRoot->count = 1;
+        newRoot->keys[0] = separator;
+        newRoot->children[0] = root;
+        newRoot->children[1] = sibling;
+        root = newRoot;
+        ++height;
+    }
+
+    // Inserts (key, value) at position index of a full leaf by splitting it. A leaf on the right
+    // edge receiving a key past its end moves only that key to the new leaf; any other leaf splits
+    // in half. Returns the new right sibling.
+    Leaf* splitLeaf(Leaf* leaf, uint32_t index, const KeyType& key, const ValueType& value) {
+        Leaf* sibling = newLeaf();
+        uint32_t splitAt = (leaf == last && index == leaf->count) ? leaf->count : leaf->count / 2;
+
+        sibling->count = leaf->count - splitAt;
+        std::copy(leaf->keys + splitAt, leaf->keys + leaf->count, sibling->keys);
+        std::copy(leaf->values + splitAt, leaf->values + leaf->count, sibling->values);
+        leaf->count = splitAt;
+        sibling->next = leaf->next;
+        leaf->next = sibling;
+        if (leaf == last) last = sibling;
+
+        if (index <= splitAt && splitAt != static_cast<uint32_t>(LEAF_CAPACITY)) {
+            insertIntoLeaf(leaf, index, key, value);
+        } else {
+            insertIntoLeaf(sibling, index - splitAt, key, value);
+        }
+        return sibling;
+    }
+
+    static void insertIntoLeaf(Leaf* leaf, uint32_t index, const KeyType& key, const ValueType& value) {
+        std::copy_backward(leaf->keys + index, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        std::copy_backward(leaf->values + index, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+        leaf->keys[index] = key;
+        leaf->values[index] = value;
+        ++leaf->count;
+    }
+
+    // Inserts separator and its right child at position index of an inner node. If the node is
+    // full it splits, following the same right-edge rule as leaves, and the key pushed up to the
+    // parent and the new right sibling are returned through pushedUp and sibling.
+    static bool insertIntoInner(Inner* inner, uint32_t index, const KeyType& separator, Node* child,
+                                bool rightEdge, KeyType& pushedUp, Inner*& sibling) {
+        if (inner->count < INNER_CAPACITY) {
+            std::copy_backward(inner->keys + index, inner->keys + inner->count, inner->keys + inner->count + 1);
+            std::copy_backward(inner->children + index + 1, inner->children + inner->count + 1, inner->children + inner->count + 2);
+            inner->keys[index] = separator;
+            inner->children[index + 1] = child;
+            ++inner->count;
+            return false;
+        }
+
+        // Lay out all keys and children, including the new ones, then split the sequence
+        KeyType keys[INNER_CAPACITY + 1];
+        Node* children[INNER_CAPACITY + 2];
+        std::copy(inner->keys, inner->keys + index, keys);
+        keys[index] = separator;
+        std::copy(inner->keys + index, inner->keys + inner->count, keys + index + 1);
+        std::copy(inner->children, inner->children + index + 1, children);
+        children[index + 1] = child;
+        std::copy(inner->children + index + 1, inner->children + inner->count + 1, children + index + 2);
+
+        size_t total = INNER_CAPACITY + 1;  // Keys in the combined sequence
+        size_t leftCount = (rightEdge && index == inner->count) ? INNER_CAPACITY - 1 : total / 2;
+
+        sibling = newInner();
+        pushedUp = keys[leftCount];
+        inner->count = static_cast<uint32_t>(leftCount);
+        std::copy(keys, keys + leftCount, inner->keys);
+        std::copy(children, children + leftCount + 1, inner->children);
+        sibling->count = static_cast<uint32_t>(total - leftCount - 1);
+        std::copy(keys + leftCount + 1, keys + total, sibling->keys);
+        std::copy(children + leftCount + 1, children + total + 1, sibling->children);
+        return true;
+    }
+
+    size_t validateNode(const Node* node, const KeyType* low, const KeyType* high, size_t depth,
+                        const Leaf*& expectedLeaf, bool& valid) const;
+
+public:
+    // Forward iterator over (key, value) pairs in key order, following the leaf links
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<KeyType, ValueType>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator() : leaf(nullptr), index(0) {}
+
+        const KeyType& key() const { return leaf->keys[index]; }
+        const ValueType& value() const { return leaf->values[index]; }
+        value_type operator*() const { return {key(), value()}; }
+
+        const_iterator& operator++() {
+            if (++index == leaf->count) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const { return leaf == other.leaf && index == other.index; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class BPlusTree;
+        const_iterator(const Leaf* leaf, uint32_t index) : leaf(leaf), index(index) {}
+
+        const Leaf* leaf;
+        uint32_t index;
+    };
+
+    // Constructor and Destructor
+    BPlusTree() : root(nullptr), first(nullptr), last(nullptr), size(0), height(0) {}
+    ~BPlusTree() { destroy(root); }
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    BPlusTree(BPlusTree&& other) noexcept
+        : root(other.root), first(other.first), last(other.last), size(other.size), height(other.height) {
+        other.root = nullptr;
+        other.first = other.last = nullptr;
+        other.size = other.height = 0;
+    }
+
+    BPlusTree& operator=(BPlusTree&& other) noexcept {
+        std::swap(root, other.root);
+        std::swap(first, other.first);
+        std::swap(last, other.last);
+        std::swap(size, other.size);
+        std::swap(height, other.height);
+        return *this;
+    }
+
+    // Removes every entry
+    void clear() {
+        destroy(root);
+        root = nullptr;
+        first = last = nullptr;
+        size = height = 0;
+    }
+
+    // Insert a key-value pair, replacing the value if the key is already present
+    void insert(const KeyType& key, const ValueType& value) {
+        if (!root) {
+            root = first = last = newLeaf();
+            height = 1;
+        }
+
+        // Append fast path: a key past the end goes straight to the rightmost leaf
+        if (last->count > 0 && last->count < LEAF_CAPACITY && last->keys[last->count - 1] < key) {
+            last->keys[last->count] = key;
+            last->values[last->count] = value;
+            ++last->count;
+            ++size;
+            return;
+        }
+
+        // Descend, remembering each inner node and the child taken so splits can propagate up
+        Inner* path[MAX_HEIGHT];
+        uint32_t slots[MAX_HEIGHT];
+        size_t depth = 0;
+        Node* node = root;
+        while (!node->leaf) {
+            Inner* inner = static_cast<Inner*>(node);
+            uint32_t index = childIndex(inner, key);
+            path[depth] = inner;
+            slots[depth++] = index;
+            node = inner->children[index];
+        }
+
+        Leaf* leaf = static_cast<Leaf*>(node);
+        uint32_t index = static_cast<uint32_t>(std::lower_bound(leaf->keys, leaf->keys + leaf->count, key) - leaf->keys);
+        if (index < leaf->count && !(key < leaf->keys[index])) {
+            leaf->values[index] = value;    // Update value if key already exists
+            return;
+        }
+        ++size;
+        if (leaf->count < LEAF_CAPACITY) {
+            insertIntoLeaf(leaf, index, key, value);
+            return;
+        }
+
+        // Every node on the path to the last leaf is the rightmost of its level
+        bool rightEdge = leaf == last && index == leaf->count;
+        Leaf* newLeafNode = splitLeaf(leaf, index, key, value);
+        KeyType separator = newLeafNode->keys[0];
+        Node* child = newLeafNode;
+        while (depth > 0) {
+            --depth;
+            Inner* sibling = nullptr;
+            KeyType pushedUp{};
+            if (!insertIntoInner(path[depth], slots[depth], separator, child, rightEdge, pushedUp, sibling)) {
+                return;
+            }
+            separator = pushedUp;
+            child = sibling;
+        }
+        growRoot(child, separator);
+    }
+
+    // Replaces the contents with pairs from a range sorted by strictly increasing key, packing
+    // each leaf to fillFactor of its capacity. Throws std::invalid_argument if the keys are not
+    // strictly increasing or fillFactor is not in (0, 1].
+    template <typename Iterator>
+    void bulkLoad(Iterator begin, Iterator end, double fillFactor = 1.0) {
+        if (!(fillFactor > 0.0 && fillFactor <= 1.0)) {
+            throw std::invalid_argument("Fill factor must be in (0, 1]");
+        }
+        clear();
+        if (begin == end) return;
+
+        size_t leafFill = std::max<size_t>(1, static_cast<size_t>(LEAF_CAPACITY * fillFactor));
+        size_t innerFill = std::max<size_t>(2, static_cast<size_t>(INNER_CAPACITY * fillFactor));
+
+        // Build the leaf level, chained left to right
+        std::vector<Node*> level;
+        std::vector<KeyType> lowKeys;  // Smallest key under each node of the current level
+        Leaf* leaf = nullptr;
+        for (Iterator it = begin; it != end; ++it) {
+            const KeyType& key = it->first;
+            if (leaf && !(leaf->keys[leaf->count - 1] < key)) {
+                destroyLeaves(first);
+                first = nullptr;
+                size = 0;
+                throw std::invalid_argument("bulkLoad requires strictly increasing keys");
+            }
+            if (!leaf || leaf->count == leafFill) {
+                Leaf* next = newLeaf();
+                if (leaf) {
+                    leaf->next = next;
+                } else {
+                    first = next;
+                }
+                leaf = next;
+                level.push_back(leaf);
+                lowKeys.push_back(key);
+            }
+            leaf->keys[leaf->count] = key;
+            leaf->values[leaf->count] = it->second;
+            ++leaf->count;
+            ++size;
+        }
+        last = leaf;
+        height = 1;
+
+        // Build each inner level from the one below until a single node remains
+        while (level.size() > 1) {
+            std::vector<Node*> parents;
+            std::vector<KeyType> parentLowKeys;
+            for (size_t i = 0; i < level.size();) {
+                size_t take = std::min(innerFill + 1, level.size() - i);
+                if (level.size() - i - take == 1) --take;   // Never leave a parent with a single child
+                Inner* inner = newInner();
+                inner->children[0] = level[i];
+                for (size_t j = 1; j < take; ++j) {
+                    inner->keys[j - 1] = lowKeys[i + j];
+                    inner->children[j] = level[i + j];
+                }
+                inner->count = static_cast<uint32_t>(take - 1);
+                parents.push_back(inner);
+                parentLowKeys.push_back(lowKeys[i]);
+                i += take;
+            }
+            level = std::move(parents);
+            lowKeys = std::move(parentLowKeys);
+            ++height;
+        }
+        root = level[0];
+    }
+
+    // Retrieve a value by key
+    std::optional<ValueType> retrieve(const KeyType& key) const {
+        if (!root) return std::nullopt;
+        const Leaf* leaf = findLeaf(key);
+        const KeyType* position = std::lower_bound(leaf->keys, leaf->keys + leaf->count, key);
+        if (position == leaf->keys + leaf->count || key < *position) {
+            return std::nullopt; // Key not found
+        }
+        return leaf->values[position - leaf->keys];
+    }
+
+    // First entry whose key is not less than key
+    const_iterator lowerBound(const KeyType& key) const {
+        if (!root) return end();
+        const Leaf* leaf = findLeaf(key);
+        uint32_t index = static_cast<uint32_t>(std::lower_bound(leaf->keys, leaf->keys + leaf->count, key) - leaf->keys);
+        if (index == leaf->count) {
+            return const_iterator(leaf->next, 0);   // Every key in this leaf is smaller
+        }
+        return const_iterator(leaf, index);
+    }
+
+    // First entry whose key is greater than key
+    const_iterator upperBound(const KeyType& key) const {
+        const_iterator it = lowerBound(key);
+        if (it != end() && !(key < it.key())) ++it;
+        return it;
+    }
+
+    const_iterator begin() const { return first ? const_iterator(first, 0) : end(); }
+    const_iterator end() const { return const_iterator(nullptr, 0); }
+
+    // Calls visitor(key, value) for every entry with low <= key <= high, in key order
+    template <typename Visitor>
+    void forEachInRange(const KeyType& low, const KeyType& high, Visitor visitor) const {
+        if (!root || high < low) return;
+        const Leaf* leaf = findLeaf(low);
+        uint32_t index = static_cast<uint32_t>(std::lower_bound(leaf->keys, leaf->keys + leaf->count, low) - leaf->keys);
+        for (; leaf; leaf = leaf->next, index = 0) {
+            for (; index < leaf->count; ++index) {
+                if (high < leaf->keys[index]) return;
+                visitor(leaf->keys[index], leaf->values[index]);
+            }
+        }
+    }
+
+    // Calls visitor(key, value) for every entry, in key order
+    template <typename Visitor>
+    void forEach(Visitor visitor) const {
+        for (const Leaf* leaf = first; leaf; leaf = leaf->next) {
+            for (uint32_t i = 0; i < leaf->count; ++i) {
+                visitor(leaf->keys[i], leaf->values[i]);
+            }
+        }
+    }
+
+    // Largest key; throws std::out_of_range if the tree is empty
+    KeyType maximumKey() const {
+        if (size == 0) throw std::out_of_range("BPlusTree is empty");
+        return last->keys[last->count - 1];
+    }
+
+    // Smallest key; throws std::out_of_range if the tree is empty
+    KeyType minimumKey() const {
+        if (size == 0) throw std::out_of_range("BPlusTree is empty");
+        return first->keys[0];
+    }
+
+    // Checks key order within and across nodes, that every separator bounds its subtrees, that all
+    // leaves sit at the same depth and that the leaf chain visits every leaf in order
+    bool isValid() const {
+        if (!root) return size == 0 && height == 0 && !first && !last;
+        const Leaf* expectedLeaf = first;
+        bool valid = true;
+        size_t counted = validateNode(root, nullptr, nullptr, 1, expectedLeaf, valid);
+        return valid && counted == size && expectedLeaf == nullptr;
+    }
+
+    // Get the number of entries
+    size_t getSize() const {
+        return size;
+    }
+
+    // Get the number of levels, counting the leaves
+    size_t getHeight() const {
+        return height;
+    }
+
+    bool empty() const {
+        return size == 0;
+    }
+};
+
+// Walks a subtree, checking it against the separator bounds [low, high) and returning its entry count
+template <typename KeyType, typename ValueType, size_t NodeBytes>
+size_t BPlusTree<KeyType, ValueType, NodeBytes>::validateNode(const Node* node, const KeyType* low, const KeyType* high,
+                                                              size_t depth, const Leaf*& expectedLeaf, bool& valid) const {
+    if (node->leaf) {
+        const Leaf* leaf = static_cast<const Leaf*>(node);
+        if (depth != height || leaf != expectedLeaf || leaf->count == 0) valid = false;
+        for (uint32_t i = 0; i < leaf->count; ++i) {
+            if ((i > 0 && !(leaf->keys[i - 1] < leaf->keys[i])) ||
+                (low && leaf->keys[i] < *low) || (high && !(leaf->keys[i] < *high))) {
+                valid = false;
+            }
+        }
+        if (!leaf->next && leaf != last) valid = false;
+        expectedLeaf = leaf->next;
+        return leaf->count;
+    }
+
+    const Inner* inner = static_cast<const Inner*>(node);
+    if (inner->count == 0) valid = false;
+    size_t total = 0;
+    for (uint32_t i = 0; i <= inner->count && valid; ++i) {
+        if (i > 0 && i < inner->count && !(inner->keys[i - 1] < inner->keys[i])) valid = false;
+        const KeyType* childLow = i == 0 ? low : &inner->keys[i - 1];
+        const KeyType* childHigh = i == inner->count ? high : &inner->keys[i];
+        total += validateNode(inner->children[i], childLow, childHigh, depth + 1, expectedLeaf, valid);
+    }
+    return total;
+}
+
+// Index from bar timestamps (seconds since the epoch) to offsets into a series
+using TimestampIndex = BPlusTree<int64_t, uint32_t>;
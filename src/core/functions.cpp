@@ -4,23 +4,53 @@
 #include <string>
 #include <fstream>
 #include <numeric>
+#include <algorithm>
+#include <cmath>
 #include <curl/curl.h>
 #include "functions.h"
 #include "../database/database_utils.h"
+#include "../binary_tree/balanced_binary_tree.h"
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
 namespace StockScanner {
 
-    // Define a map to store the timeframe-related information
-    const std::unordered_map<std::string, TimeframeInfo> timeframeMap = {
-        {"5min", {"TIME_SERIES_INTRADAY&interval=5min", "Time Series (5min)"}},
-        {"15min", {"TIME_SERIES_INTRADAY&interval=15min", "Time Series (15min)"}},
-        {"daily", {"TIME_SERIES_DAILY", "Time Series (Daily)"}},
-        {"hourly", {"TIME_SERIES_INTRADAY&interval=60min", "Time Series (60min)"}}
+    // Timeframe names interned in table order, so each name's SymbolId indexes its info
+    struct Timeframes {
+        SymbolTable symbols;
+        std::vector<TimeframeInfo> infos;
+
+        Timeframes() {
+            add("5min", {"TIME_SERIES_INTRADAY&interval=5min", "Time Series (5min)"});
+            add("15min", {"TIME_SERIES_INTRADAY&interval=15min", "Time Series (15min)"});
+            add("daily", {"TIME_SERIES_DAILY", "Time Series (Daily)"});
+            add("hourly", {"TIME_SERIES_INTRADAY&interval=60min", "Time Series (60min)"});
+        }
+
+        void add(const std::string& name, TimeframeInfo info) {
+            symbols.intern(name);
+            infos.push_back(std::move(info));
+        }
     };
 
+    static const Timeframes& timeframes() {
+        static const Timeframes table;
+        return table;
+    }
+
+    const SymbolTable& timeframeSymbols() {
+        return timeframes().symbols;
+    }
+
+    const TimeframeInfo& timeframeInfo(SymbolId timeframe) {
+        return timeframes().infos.at(timeframe);
+    }
+
+    SymbolId defaultTimeframe() {
+        return *timeframes().symbols.find("daily");
+    }
+
     // Callback function for curl to handle data received from HTTP response
     // Appends the response data to the provided string
     size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
@@ -45,20 +75,20 @@ namespace StockScanner {
     }
 
     // Fetches stock price data from an API given a ticker symbol
-    std::vector<double> loadStockData(const std::string& ticker, const std::string& timeframe) {
+    std::vector<double> loadStockData(const SymbolTable& symbols, SymbolId ticker, SymbolId timeframe) {
 
         // Check if timeframe is supported
-        auto it = timeframeMap.find(timeframe);
-        if (it == timeframeMap.end()) {
-            std::cerr << "Unsupported timeframe: " << timeframe << "\n";
+        if (timeframe >= timeframeSymbols().size()) {
+            std::cerr << "Unsupported timeframe ID: " << timeframe << "\n";
             return {};
         }
 
-        const TimeframeInfo& tfInfo = it->second;
+        const TimeframeInfo& tfInfo = timeframeInfo(timeframe);
+        const std::string& tickerName = symbols.name(ticker);
 
-        if (checkStockDataExists(ticker)) {
+        if (checkStockDataExists(tickerName)) {
             std::cout << "Stock data already exists in the database.\n";
-            return getStockDataFromDatabase(ticker);  // Retrieve data from the database
+            return getStockDataFromDatabase(symbols, ticker);  // Retrieve data from the database
         }
 
     #ifndef UNIT_TESTING
@@ -80,7 +110,7 @@ namespace StockScanner {
 
             // Construct API request URL
             std::string url = "https://www.alphavantage.co/query?function=" + tfInfo.apiFunction +
-                              "&symbol=" + ticker +
+                              "&symbol=" + tickerName +
                               "&apikey=" + apiKey;
 
             // Set curl options for URL and callback function
@@ -113,7 +143,7 @@ namespace StockScanner {
 
                     // Insert the data into the SQLite database
                     if (!dataToInsert.empty()) {
-                        insertStockData(ticker, dataToInsert);
+                        insertStockData(tickerName, dataToInsert);
                     }
 
                     std::cout << "Data parsed successfully: \n";
@@ -178,4 +208,40 @@ namespace StockScanner {
         // Continue recursion
         return detectMomentum(prices, index + 1, trendCount);
     }
+
+    // Computes a percentile of each sliding window using a balanced order-statistic tree.
+    // Each step adds the newest price and removes the one leaving the window, then
+    // selects the two closest ranks, instead of sorting a copy of every window.
+    std::vector<double> calculateRollingPercentile(const std::vector<double>& prices, size_t windowSize, double percentile) {
+        std::vector<double> result;
+        if (windowSize == 0 || windowSize > prices.size()) {
+            return result;
+        }
+
+        // Fractional rank of the percentile within a sorted window
+        double position = std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(windowSize - 1);
+        size_t lowerRank = static_cast<size_t>(std::floor(position));
+        size_t upperRank = std::min(lowerRank + 1, windowSize - 1);
+        double fraction = position - static_cast<double>(lowerRank);
+
+        BalancedBinaryTree<double, true, true> window;   // Pooled: each step frees one node and reuses it
+        result.reserve(prices.size() - windowSize + 1);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            window.Add(prices[i]);
+            if (i >= windowSize) {
+                window.Remove(prices[i - windowSize]);
+            }
+            if (i + 1 >= windowSize) {
+                double lower = window.Select(lowerRank);
+                double upper = fraction > 0.0 ? window.Select(upperRank) : lower;
+                result.push_back(lower + (upper - lower) * fraction);
+            }
+        }
+        return result;
+    }
+
+    // Computes the median of each sliding window
+    std::vector<double> calculateRollingMedian(const std::vector<double>& prices, size_t windowSize) {
+        return calculateRollingPercentile(prices, windowSize, 50.0);
+    }
 }
\ No newline at end of file
@@ -4,12 +4,14 @@
 #include <string>
 #include <deque>
 #include <sqlite3.h>
-#include <unordered_map> 
+#include "symbol_table.h"
 
 namespace StockScanner {
     void showMenu(double threshold, size_t windowSize);
 
-    std::vector<double> loadStockData(const std::string& ticker, const std::string& timeframe);
+    // Loads the close prices of an interned ticker, from the database if stored, otherwise from the
+    // API for the given timeframe (an ID from timeframeSymbols())
+    std::vector<double> loadStockData(const SymbolTable& symbols, SymbolId ticker, SymbolId timeframe);
 
     double calculateAveragePrice(const std::vector<double>& prices);
 
@@ -19,10 +21,24 @@ namespace StockScanner {
 
     bool detectMomentum(const std::deque<double>& prices, size_t index = 0, int trendCount = 0);
 
+    // Percentile (0-100) of every full sliding window, interpolating between the closest ranks.
+    // Returns prices.size() - windowSize + 1 values, or none if the window is empty or too large.
+    std::vector<double> calculateRollingPercentile(const std::vector<double>& prices, size_t windowSize, double percentile);
+
+    std::vector<double> calculateRollingMedian(const std::vector<double>& prices, size_t windowSize);
+
     struct TimeframeInfo {
         std::string apiFunction;
         std::string jsonKey;
     };
-    
-    extern const std::unordered_map<std::string, TimeframeInfo> timeframeMap;
+
+    // Supported timeframe names ("5min", "15min", "daily", "hourly"), interned once so a timeframe
+    // is passed around as its SymbolId in this table
+    const SymbolTable& timeframeSymbols();
+
+    // API settings of a timeframe; throws std::out_of_range for an ID timeframeSymbols() never assigned
+    const TimeframeInfo& timeframeInfo(SymbolId timeframe);
+
+    // ID of "daily", the default timeframe
+    SymbolId defaultTimeframe();
 }
\ No newline at end of file
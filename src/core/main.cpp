@@ -1,15 +1,29 @@
 #include <iostream>
 #include <vector>
+#include <limits>
 #include "functions.h"
+#include "range_index.h"
 #include "../database/database_utils.h"
 #include "../sorting/sorting_analysis.h"
+#include "../sorting/sorting_benchmark.h"
 #include "../menu/menu_actions.h"
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Non-interactive sorting benchmark: StockScanner --sort-benchmark [options]
+    if (argc > 1 && std::string(argv[1]) == "--sort-benchmark") {
+        SortBenchmarkConfig config;
+        if (!parseSortBenchmarkArgs(argc, argv, config)) return 1;
+        runSortBenchmark(config);
+        return 0;
+    }
+
     int choice;
     int menuLevel = 1;
     std::vector<double> stockPrices;
-    std::string timeframe = "daily";    // Default timeframe
+    StockScanner::RangeIndex priceIndex; // Window statistics over stockPrices
+    StockScanner::SymbolTable symbols;  // Tickers seen this session, as dense IDs
+    StockScanner::SymbolId ticker = 0;  // ID of the ticker whose prices are loaded
+    StockScanner::SymbolId timeframe = StockScanner::defaultTimeframe();
     double threshold = 5.0;             // Default threshold percentage
     size_t windowSize = 3;              // Default sliding window size
 
@@ -40,19 +54,29 @@ int main() {
                 break;
             }
         } else if (menuLevel == 2) {
-            if (choice == 1) MenuActions::getStockData(stockPrices, timeframe);
+            if (choice == 1) MenuActions::getStockData(stockPrices, priceIndex, symbols, ticker, timeframe);
             else if (choice == 2) MenuActions::calculateAverage(stockPrices);
             else if (choice == 3) MenuActions::checkThreshold(stockPrices, threshold);
-            else if (choice == 4) menuLevel = 1;
+            else if (choice == 4) MenuActions::runScreen(stockPrices);
+            else if (choice == 5) MenuActions::windowStatistics(priceIndex);
+            else if (choice == 6) MenuActions::rankStoredTickers(symbols);
+            else if (choice == 7) menuLevel = 1;
         } else if (menuLevel == 3) {
             if (choice == 1) MenuActions::modifyThreshold(threshold);
             else if (choice == 2) MenuActions::applySlidingWindow(stockPrices, windowSize);
             else if (choice == 3) MenuActions::modifyWindowSize(windowSize);
             else if (choice == 4) MenuActions::detectMomentum(stockPrices, windowSize);
-            else if (choice == 5) menuLevel = 1;
+            else if (choice == 5) MenuActions::rollingMedian(stockPrices, windowSize);
+            else if (choice == 6) MenuActions::backtestParameters(stockPrices, ticker);
+            else if (choice == 7) menuLevel = 1;
         } else if (menuLevel == 4) {
             if (choice == 1) runSortingAnalysis();
-            else if (choice == 2) menuLevel = 1;
+            else if (choice == 2) {
+                SortBenchmarkConfig config;
+                config.shapes = allInputShapes();
+                runSortBenchmark(config);
+            }
+            else if (choice == 3) menuLevel = 1;
         }
     }
 
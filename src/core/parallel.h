@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace StockScanner {
+
+    // Number of worker threads to use for parallel work (at least one)
+    inline size_t workerCount() {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads == 0 ? 1 : static_cast<size_t>(hardwareThreads);
+    }
+
+    // Calls task(i) for every i in [0, count) across the worker threads.
+    // Indices are handed out dynamically so uneven tasks still balance.
+    template <typename Task>
+    void parallelFor(size_t count, Task task) {
+        size_t threads = std::min(workerCount(), count);
+        if (threads <= 1) {
+            for (size_t i = 0; i < count; ++i) {
+                task(i);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+                task(i);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (size_t t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#include "range_index.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace StockScanner {
+
+    RangeIndex::RangeIndex() : shift(0.0), prefixSums(1, 0.0), prefixSquares(1, 0.0), floorLog2(1, 0) {}
+
+    RangeIndex::RangeIndex(const std::vector<double>& prices) : RangeIndex() {
+        build(prices);
+    }
+
+    void RangeIndex::build(const std::vector<double>& prices) {
+        shift = prices.empty() ? 0.0 : prices.front();
+        prefixSums.assign(1, 0.0);
+        prefixSquares.assign(1, 0.0);
+        floorLog2.assign(1, 0);
+        minimums.clear();
+        maximums.clear();
+
+        prefixSums.reserve(prices.size() + 1);
+        prefixSquares.reserve(prices.size() + 1);
+        floorLog2.reserve(prices.size() + 1);
+        for (double price : prices) {
+            append(price);
+        }
+    }
+
+    void RangeIndex::append(double price) {
+        if (empty()) {
+            shift = price;
+        }
+
+        double shifted = price - shift;
+        prefixSums.push_back(prefixSums.back() + shifted);
+        prefixSquares.push_back(prefixSquares.back() + shifted * shifted);
+
+        const size_t n = size();
+        floorLog2.push_back(n == 1 ? 0 : static_cast<uint8_t>(floorLog2[n / 2] + 1));
+
+        // The new value completes exactly one range of each power-of-two length: the one ending at it
+        if (minimums.empty()) {
+            minimums.emplace_back();
+            maximums.emplace_back();
+        }
+        minimums[0].push_back(price);
+        maximums[0].push_back(price);
+        for (size_t level = 1; (size_t(1) << level) <= n; ++level) {
+            if (level == minimums.size()) {
+                minimums.emplace_back();
+                maximums.emplace_back();
+            }
+            const size_t half = size_t(1) << (level - 1);
+            const size_t start = n - (size_t(1) << level);
+            minimums[level].push_back(std::min(minimums[level - 1][start], minimums[level - 1][start + half]));
+            maximums[level].push_back(std::max(maximums[level - 1][start], maximums[level - 1][start + half]));
+        }
+    }
+
+    void RangeIndex::checkRange(size_t start, size_t length) const {
+        if (length == 0 || start >= size() || length > size() - start) {
+            throw std::out_of_range("Window is outside the indexed series");
+        }
+    }
+
+    double RangeIndex::sum(size_t start, size_t length) const {
+        checkRange(start, length);
+        return prefixSums[start + length] - prefixSums[start] + shift * static_cast<double>(length);
+    }
+
+    double RangeIndex::mean(size_t start, size_t length) const {
+        checkRange(start, length);
+        return (prefixSums[start + length] - prefixSums[start]) / static_cast<double>(length) + shift;
+    }
+
+    double RangeIndex::variance(size_t start, size_t length) const {
+        checkRange(start, length);
+        if (length < 2) return 0.0;
+
+        // Variance is shift-invariant, so it is computed directly from the shifted sums
+        const double n = static_cast<double>(length);
+        const double total = prefixSums[start + length] - prefixSums[start];
+        const double squares = prefixSquares[start + length] - prefixSquares[start];
+        return std::max(0.0, (squares - total * total / n) / (n - 1.0));
+    }
+
+    double RangeIndex::minimum(size_t start, size_t length) const {
+        checkRange(start, length);
+        const size_t level = floorLog2[length];
+        return std::min(minimums[level][start], minimums[level][start + length - (size_t(1) << level)]);
+    }
+
+    double RangeIndex::maximum(size_t start, size_t length) const {
+        checkRange(start, length);
+        const size_t level = floorLog2[length];
+        return std::max(maximums[level][start], maximums[level][start + length - (size_t(1) << level)]);
+    }
+}
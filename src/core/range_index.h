@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace StockScanner {
+
+    // Per-series index answering window statistics in O(1) for any (start, length) range.
+    // Prefix sums of values and squared values give the sum, mean and variance; a sparse
+    // table of power-of-two range minima and maxima gives the min and max from two
+    // overlapping lookups. Built once when a series is loaded and extended as bars arrive.
+    class RangeIndex {
+    public:
+        RangeIndex();
+        explicit RangeIndex(const std::vector<double>& prices);
+
+        // Discards the current contents and indexes the given series
+        void build(const std::vector<double>& prices);
+
+        // Extends the index by one value in O(log n)
+        void append(double price);
+
+        size_t size() const { return prefixSums.size() - 1; }
+        bool empty() const { return size() == 0; }
+
+        // Window queries; each throws std::out_of_range if the window is empty or
+        // extends past the end of the series
+        double sum(size_t start, size_t length) const;
+        double mean(size_t start, size_t length) const;
+        double variance(size_t start, size_t length) const;  // Sample variance; 0 for a single value
+        double minimum(size_t start, size_t length) const;
+        double maximum(size_t start, size_t length) const;
+
+    private:
+        double shift;                              // First value; sums are kept relative to it for precision
+        std::vector<double> prefixSums;            // prefixSums[i] = sum of (value - shift) over [0, i)
+        std::vector<double> prefixSquares;         // Same for the squared shifted values
+        std::vector<std::vector<double>> minimums; // minimums[k][i] = min over [i, i + 2^k)
+        std::vector<std::vector<double>> maximums; // maximums[k][i] = max over [i, i + 2^k)
+        std::vector<uint8_t> floorLog2;            // floorLog2[n] for every window length up to size()
+
+        void checkRange(size_t start, size_t length) const;
+    };
+}
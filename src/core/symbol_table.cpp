@@ -0,0 +1,29 @@
+#include "symbol_table.h"
+#include <stdexcept>
+
+namespace StockScanner {
+
+    SymbolId SymbolTable::intern(std::string_view name) {
+        if (auto existing = ids.retrieve(name)) {
+            return *existing;
+        }
+        if (names.size() >= UINT32_MAX) {
+            throw std::length_error("Symbol table is full");
+        }
+        SymbolId id = static_cast<SymbolId>(names.size());
+        names.emplace_back(name);
+        ids.insert(names.back(), id);
+        return id;
+    }
+
+    std::optional<SymbolId> SymbolTable::find(std::string_view name) const {
+        return ids.retrieve(name);
+    }
+
+    const std::string& SymbolTable::name(SymbolId id) const {
+        if (id >= names.size()) {
+            throw std::out_of_range("Unknown symbol ID " + std::to_string(id));
+        }
+        return names[id];
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "../hash_tables/hash_table.h"
+
+namespace StockScanner {
+
+    // Dense integer handle for an interned ticker or timeframe name
+    using SymbolId = uint32_t;
+
+    // Interns names such as tickers into dense IDs 0, 1, 2, ... in first-seen order, so
+    // per-symbol state can live in flat arrays indexed by ID and compare or hash as one integer.
+    // Lookups take std::string_view, so names parsed out of a larger buffer need no copy.
+    // Not synchronized: intern before sharing a table across threads; concurrent const calls are safe.
+    class SymbolTable {
+    public:
+        // ID of name, assigning the next one if name is new
+        SymbolId intern(std::string_view name);
+
+        // ID of name if it has been interned
+        std::optional<SymbolId> find(std::string_view name) const;
+
+        // Name of an interned ID; throws std::out_of_range for an ID this table never assigned.
+        // The reference stays valid for the table's lifetime.
+        const std::string& name(SymbolId id) const;
+
+        size_t size() const { return names.size(); }
+        bool empty() const { return names.empty(); }
+
+    private:
+        std::deque<std::string> names;      // Indexed by ID; a deque so references survive growth
+        StringHashTable<SymbolId> ids;
+    };
+}
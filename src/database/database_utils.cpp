@@ -1,6 +1,9 @@
 #include "database_utils.h"
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
+#include <cstdio>
+#include <stdexcept>
 
 namespace StockScanner {
 
@@ -109,14 +112,15 @@ namespace StockScanner {
     }
 
     // Load stock data if it exists in database
-    std::vector<double> getStockDataFromDatabase(const std::string& ticker) {
+    std::vector<double> getStockDataFromDatabase(const SymbolTable& symbols, SymbolId ticker) {
         std::vector<double> prices;
         sqlite3* db = nullptr;
         sqlite3_stmt* stmt = nullptr;
 
-        int rc = sqlite3_open("stock_data.db", &db);
+        int rc = sqlite3_open(DATABASE_NAME, &db);
         if (rc != SQLITE_OK) {
             std::cerr << "Failed to open the database: " << sqlite3_errmsg(db) << "\n";
+            sqlite3_close(db);
             return prices;
         }
 
@@ -128,7 +132,7 @@ namespace StockScanner {
             return prices;
         }
 
-        sqlite3_bind_text(stmt, 1, ticker.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 1, symbols.name(ticker).c_str(), -1, SQLITE_STATIC);
 
         while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
             double price = sqlite3_column_double(stmt, 0);
@@ -145,6 +149,214 @@ namespace StockScanner {
         return prices;
     }
 
+    // Load every close price in the database, one ticker's series after another
+    std::vector<double> getAllClosePricesFromDatabase() {
+        std::vector<double> prices;
+        sqlite3* db = nullptr;
+        sqlite3_stmt* stmt = nullptr;
+
+        int rc = sqlite3_open(DATABASE_NAME, &db);
+        if (rc != SQLITE_OK) {
+            std::cerr << "Failed to open the database: " << sqlite3_errmsg(db) << "\n";
+            sqlite3_close(db);
+            return prices;
+        }
+
+        const char* sql = "SELECT close_price FROM stock_data ORDER BY ticker, datetime;";
+        rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
+        if (rc != SQLITE_OK) {
+            std::cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << "\n";
+            sqlite3_close(db);
+            return prices;
+        }
+
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+            prices.push_back(sqlite3_column_double(stmt, 0));
+        }
+
+        if (rc != SQLITE_DONE) {
+            std::cerr << "Failed to retrieve data: " << sqlite3_errmsg(db) << "\n";
+        }
+
+        sqlite3_finalize(stmt);
+        sqlite3_close(db);
+
+        return prices;
+    }
+
+    // Load every ticker's series in one ordered pass, interning each ticker once when its rows begin
+    std::vector<std::vector<double>> getAllStockSeriesFromDatabase(SymbolTable& symbols) {
+        std::vector<std::vector<double>> series(symbols.size());
+        sqlite3* db = nullptr;
+        sqlite3_stmt* stmt = nullptr;
+
+        int rc = sqlite3_open(DATABASE_NAME, &db);
+        if (rc != SQLITE_OK) {
+            std::cerr << "Failed to open the database: " << sqlite3_errmsg(db) << "\n";
+            sqlite3_close(db);
+            return series;
+        }
+
+        const char* sql = "SELECT ticker, close_price FROM stock_data ORDER BY ticker, datetime;";
+        rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
+        if (rc != SQLITE_OK) {
+            std::cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << "\n";
+            sqlite3_close(db);
+            return series;
+        }
+
+        std::string currentTicker;
+        std::vector<double>* current = nullptr;
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+            std::string_view ticker(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
+                                    static_cast<size_t>(sqlite3_column_bytes(stmt, 0)));
+            if (current == nullptr || ticker != currentTicker) {
+                SymbolId id = symbols.intern(ticker);
+                if (id >= series.size()) series.resize(id + 1);
+                currentTicker.assign(ticker);
+                current = &series[id];
+            }
+            current->push_back(sqlite3_column_double(stmt, 1));
+        }
+
+        if (rc != SQLITE_DONE) {
+            std::cerr << "Failed to retrieve data: " << sqlite3_errmsg(db) << "\n";
+        }
+
+        sqlite3_finalize(stmt);
+        sqlite3_close(db);
+
+        return series;
+    }
+
+    // Load close prices for several tickers, keeping only datetimes present for every ticker
+    std::vector<std::vector<double>> getAlignedStockDataFromDatabase(const SymbolTable& symbols,
+                                                                     const std::vector<SymbolId>& tickers) {
+        std::vector<std::vector<double>> aligned(tickers.size());
+        if (tickers.empty()) return aligned;
+
+        sqlite3* db = nullptr;
+        sqlite3_stmt* stmt = nullptr;
+
+        int rc = sqlite3_open(DATABASE_NAME, &db);
+        if (rc != SQLITE_OK) {
+            std::cerr << "Failed to open the database: " << sqlite3_errmsg(db) << "\n";
+            sqlite3_close(db);
+            return aligned;
+        }
+
+        const char* sql = "SELECT datetime, close_price FROM stock_data WHERE ticker = ? ORDER BY datetime;";
+        rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
+        if (rc != SQLITE_OK) {
+            std::cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << "\n";
+            sqlite3_close(db);
+            return aligned;
+        }
+
+        // Load every ticker with the same prepared statement, counting how many tickers have each datetime
+        std::vector<std::vector<std::pair<std::string, double>>> histories(tickers.size());
+        std::unordered_map<std::string, size_t> datetimeCounts;
+        for (size_t i = 0; i < tickers.size(); ++i) {
+            sqlite3_reset(stmt);
+            sqlite3_bind_text(stmt, 1, symbols.name(tickers[i]).c_str(), -1, SQLITE_STATIC);
+
+            while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+                std::string datetime(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+                histories[i].emplace_back(datetime, sqlite3_column_double(stmt, 1));
+                ++datetimeCounts[datetime];
+            }
+
+            if (rc != SQLITE_DONE) {
+                std::cerr << "Failed to retrieve data: " << sqlite3_errmsg(db) << "\n";
+            }
+        }
+
+        sqlite3_finalize(stmt);
+        sqlite3_close(db);
+
+        // Keep the datetimes every ticker has; each history is already in datetime order
+        for (size_t i = 0; i < tickers.size(); ++i) {
+            for (const auto& [datetime, price] : histories[i]) {
+                if (datetimeCounts[datetime] == tickers.size()) {
+                    aligned[i].push_back(price);
+                }
+            }
+        }
+
+        return aligned;
+    }
+
+    int64_t parseTimestamp(const std::string& datetime) {
+        int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+        int dateEnd = -1, minuteEnd = -1, secondEnd = -1;     // Characters consumed after each form
+        int fields = std::sscanf(datetime.c_str(), "%4d-%2d-%2d%n %2d:%2d%n:%2d%n",
+                                 &year, &month, &day, &dateEnd, &hour, &minute, &minuteEnd, &second, &secondEnd);
+        int consumed = fields == 3 ? dateEnd : fields == 5 ? minuteEnd : fields == 6 ? secondEnd : -1;
+        if (consumed < 0 || datetime[consumed] != '\0' || month < 1 || month > 12 || day < 1 || day > 31 ||
+            hour > 23 || minute > 59 || second > 60 || hour < 0 || minute < 0 || second < 0) {
+            throw std::invalid_argument("Invalid datetime: " + datetime);
+        }
+
+        // Days from 1970-01-01 to the civil date (proleptic Gregorian calendar)
+        int64_t y = year - (month <= 2 ? 1 : 0);
+        int64_t era = (y >= 0 ? y : y - 399) / 400;
+        int64_t yearOfEra = y - era * 400;
+        int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        int64_t days = era * 146097 + dayOfEra - 719468;
+
+        return days * 86400 + hour * 3600 + minute * 60 + second;
+    }
+
+    // Load timestamped bars for several tickers with one prepared statement
+    std::vector<std::vector<PriceBar>> getStockBarsFromDatabase(const SymbolTable& symbols,
+                                                                const std::vector<SymbolId>& tickers) {
+        std::vector<std::vector<PriceBar>> bars(tickers.size());
+        if (tickers.empty()) return bars;
+
+        sqlite3* db = nullptr;
+        sqlite3_stmt* stmt = nullptr;
+
+        int rc = sqlite3_open(DATABASE_NAME, &db);
+        if (rc != SQLITE_OK) {
+            std::cerr << "Failed to open the database: " << sqlite3_errmsg(db) << "\n";
+            sqlite3_close(db);
+            return bars;
+        }
+
+        const char* sql = "SELECT datetime, close_price FROM stock_data WHERE ticker = ? ORDER BY datetime;";
+        rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
+        if (rc != SQLITE_OK) {
+            std::cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << "\n";
+            sqlite3_close(db);
+            return bars;
+        }
+
+        for (size_t i = 0; i < tickers.size(); ++i) {
+            const std::string& ticker = symbols.name(tickers[i]);
+            sqlite3_reset(stmt);
+            sqlite3_bind_text(stmt, 1, ticker.c_str(), -1, SQLITE_STATIC);
+
+            while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+                std::string datetime(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+                try {
+                    bars[i].push_back({parseTimestamp(datetime), sqlite3_column_double(stmt, 1)});
+                } catch (const std::invalid_argument& e) {
+                    std::cerr << "Skipping " << ticker << " row: " << e.what() << "\n";
+                }
+            }
+
+            if (rc != SQLITE_DONE) {
+                std::cerr << "Failed to retrieve data: " << sqlite3_errmsg(db) << "\n";
+            }
+        }
+
+        sqlite3_finalize(stmt);
+        sqlite3_close(db);
+
+        return bars;
+    }
+
     // Cleanup function to close the database connection
     void closeDatabase() {
         if (db) {
@@ -3,8 +3,25 @@
 #include <sqlite3.h>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include "../core/symbol_table.h"
 
 namespace StockScanner {
+    // One stored bar: its close price and time in seconds since the Unix epoch (UTC)
+    struct PriceBar {
+        int64_t timestamp;
+        double close;
+    };
+
+    // Orders bars by time, e.g. for merging several tickers' bars into one stream
+    struct PriceBarTimeLess {
+        bool operator()(const PriceBar& a, const PriceBar& b) const { return a.timestamp < b.timestamp; }
+    };
+
+    // Converts a stored "YYYY-MM-DD" or "YYYY-MM-DD HH:MM[:SS]" datetime to seconds since the epoch.
+    // Throws std::invalid_argument for any other format.
+    int64_t parseTimestamp(const std::string& datetime);
+
     // Function to initialize the database
     bool initializeDatabase();
 
@@ -14,8 +31,25 @@ namespace StockScanner {
     // Function to check if stock data for a specific ticker already exists
     bool checkStockDataExists(const std::string& ticker);
 
-    // Function to load stock data if it exists in database
-    std::vector<double> getStockDataFromDatabase(const std::string& ticker);
+    // Function to load an interned ticker's stored close prices, ordered by datetime
+    std::vector<double> getStockDataFromDatabase(const SymbolTable& symbols, SymbolId ticker);
+
+    // Function to load every stored close price, grouped by ticker and ordered by datetime
+    std::vector<double> getAllClosePricesFromDatabase();
+
+    // Function to load every stored ticker's close prices, interning each ticker into symbols.
+    // Returns one series per symbol ID (empty for IDs with no stored prices), ordered by datetime.
+    std::vector<std::vector<double>> getAllStockSeriesFromDatabase(SymbolTable& symbols);
+
+    // Function to load close prices for several distinct interned tickers at the datetimes they all
+    // share. Returns one series per ticker, in the order given, each ordered by datetime.
+    std::vector<std::vector<double>> getAlignedStockDataFromDatabase(const SymbolTable& symbols,
+                                                                     const std::vector<SymbolId>& tickers);
+
+    // Function to load the timestamped bars of several interned tickers, one series per ticker in
+    // the order given, each ordered by time
+    std::vector<std::vector<PriceBar>> getStockBarsFromDatabase(const SymbolTable& symbols,
+                                                                const std::vector<SymbolId>& tickers);
 
     // Closes the database connection
     void closeDatabase();
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <stdexcept>
+#include <mutex>
+#include <shared_mutex>
+#include <cstdint>
+#include <functional>
+#include "open_addressing_hash_table.h"
+
+// Hash map that many threads can read and write at once. Keys are spread over independent
+// segments by the top bits of their hash; each segment is an OpenAddressingHashTable behind its
+// own reader-writer lock, so readers of a segment run in parallel, writers only block the one
+// segment they touch, and a segment that fills up rehashes on its own while the others keep
+// serving. Segments sit on separate cache lines so their locks do not contend through false sharing.
+template <typename KeyType, typename ValueType>
+class ConcurrentHashMap {
+private:
+    using Table = OpenAddressingHashTable<KeyType, ValueType>;
+
+    struct alignas(64) Segment {
+        mutable std::shared_mutex mutex;
+        Table table;
+    };
+
+    static constexpr size_t MAX_SEGMENTS = 1 << 16;
+
+    std::vector<Segment> segments;
+    size_t segmentMask;
+
+    // Segments are picked by bits 48 and up of the table hash, which the segment tables only use
+    // once they are very large; the hash is then handed to the table so each key is hashed once
+    Segment& segmentFor(uint64_t h) {
+        return segments[static_cast<size_t>(h >> 48) & segmentMask];
+    }
+
+    const Segment& segmentFor(uint64_t h) const {
+        return segments[static_cast<size_t>(h >> 48) & segmentMask];
+    }
+
+public:
+    // Constructor; the segment count is rounded up to a power of two and the initial capacity is
+    // split evenly between the segments
+    explicit ConcurrentHashMap(size_t initialCapacity = 1024, size_t segmentCount = 64) {
+        if (segmentCount == 0 || segmentCount > MAX_SEGMENTS) {
+            throw std::invalid_argument("Segment count must be in [1, 65536]");
+        }
+        size_t rounded = 1;
+        while (rounded < segmentCount) rounded *= 2;
+
+        segments = std::vector<Segment>(rounded);
+        segmentMask = rounded - 1;
+        size_t perSegment = initialCapacity / rounded + 1;
+        for (auto& segment : segments) {
+            segment.table = Table(perSegment);
+        }
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    // Insert a key-value pair
+    void insert(const KeyType& key, const ValueType& value) {
+        const uint64_t h = Table::hash(key);
+        Segment& segment = segmentFor(h);
+        std::unique_lock<std::shared_mutex> lock(segment.mutex);
+        segment.table.insert(key, value, h);
+    }
+
+    // Retrieve a copy of the value for a key
+    std::optional<ValueType> retrieve(const KeyType& key) const {
+        const uint64_t h = Table::hash(key);
+        const Segment& segment = segmentFor(h);
+        std::shared_lock<std::shared_mutex> lock(segment.mutex);
+        return segment.table.retrieve(key, h);
+    }
+
+    // Calls visitor(const ValueType&) under the segment's read lock instead of copying the value
+    // out, for large values such as price series. Returns false if the key is absent.
+    template <typename Visitor>
+    bool visit(const KeyType& key, Visitor visitor) const {
+        const uint64_t h = Table::hash(key);
+        const Segment& segment = segmentFor(h);
+        std::shared_lock<std::shared_mutex> lock(segment.mutex);
+        const ValueType* value = segment.table.lookup(key, h);
+        if (value == nullptr) {
+            return false;
+        }
+        visitor(*value);
+        return true;
+    }
+
+    // Remove a key-value pair
+    bool remove(const KeyType& key) {
+        const uint64_t h = Table::hash(key);
+        Segment& segment = segmentFor(h);
+        std::unique_lock<std::shared_mutex> lock(segment.mutex);
+        return segment.table.remove(key, h);
+    }
+
+    // Get the current number of elements. Segments are counted one at a time, so under
+    // concurrent writes the result is only a snapshot.
+    size_t getSize() const {
+        size_t total = 0;
+        for (const auto& segment : segments) {
+            std::shared_lock<std::shared_mutex> lock(segment.mutex);
+            total += segment.table.getSize();
+        }
+        return total;
+    }
+
+    // Get the total capacity across all segments
+    size_t getCapacity() const {
+        size_t total = 0;
+        for (const auto& segment : segments) {
+            std::shared_lock<std::shared_mutex> lock(segment.mutex);
+            total += segment.table.getCapacity();
+        }
+        return total;
+    }
+
+    // Get the number of independently locked segments
+    size_t getSegmentCount() const {
+        return segments.size();
+    }
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+// Final mixing step of MurmurHash3, applied to a std::hash result before a table masks off some of
+// its bits. std::hash of an integer is often the identity, so without it keys that differ only in
+// their high bits would share a slot; after it every output bit depends on every input bit.
+inline uint64_t mixHash(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
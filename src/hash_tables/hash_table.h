@@ -1,97 +1,236 @@
 #pragma once
 
 #include <vector>
-#include <list>
 #include <functional>
 #include <optional>
 #include <stdexcept>
-
-template <typename KeyType, typename ValueType>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <cstdint>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include "hash_mix.h"
+
+// Hash for string keys that also accepts std::string_view and const char*, so tickers can be
+// looked up without building a temporary std::string. Pair it with std::equal_to<> (see
+// StringHashTable below).
+struct StringHash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view key) const {
+        return std::hash<std::string_view>{}(key);
+    }
+};
+
+// Separate chaining hash table. Nodes live in one contiguous pool and link to each other by
+// index, so there is no allocation per element and a chain walk stays inside one array; removed
+// nodes are marked free and reused by later inserts. Each node keeps its key's hash, which
+// filters out most non-matching keys before comparing them and lets a resize relink the nodes
+// without hashing again. The bucket count is a power of two so buckets are picked with a mask.
+// When both Hash and KeyEqual are transparent, retrieve and remove also accept any key type
+// they can hash and compare, such as std::string_view for std::string keys.
+template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>, typename KeyEqual = std::equal_to<KeyType>>
 class HashTable {
 private:
-    // A list of key-value pairs represents each bucket
-    using Bucket = std::list<std::pair<KeyType, ValueType>>;
-
-    std::vector<Bucket> table;    // The hash table storage
-    size_t capacity;              // Total number of buckets
-    size_t size;                  // Total number of elements
-    float loadFactor;             // Load factor threshold for resizing
+    // A key-value pair in the node pool, linked to the next node of its bucket
+    struct Node {
+        KeyType key;
+        ValueType value;
+        size_t hash;
+        uint32_t next;
+    };
+
+    static constexpr uint32_t NIL = UINT32_MAX;       // End of a chain
+    static constexpr uint32_t FREE = UINT32_MAX - 1;  // Link of a removed node, so iteration can skip it
+
+    // True when Hash and KeyEqual both declare is_transparent, enabling lookups by other key types
+    template <typename H, typename E, typename = void>
+    struct IsTransparent : std::false_type {};
+
+    template <typename H, typename E>
+    struct IsTransparent<H, E, std::void_t<typename H::is_transparent, typename E::is_transparent>> : std::true_type {};
+
+    std::vector<uint32_t> buckets;  // Index of the first node of each bucket's chain
+    std::vector<Node> nodes;        // Node pool; removed nodes stay constructed, emptied, for reuse
+    std::vector<uint32_t> freeNodes; // Removed nodes, reused last in first out
+    size_t capacity;                // Total number of buckets, a power of two
+    size_t size;                    // Total number of elements
+    float loadFactor;               // Load factor threshold for resizing
+    Hash hasher;
+    KeyEqual equal;
+
+    template <typename K>
+    size_t hash(const K& key) const {
+        return static_cast<size_t>(mixHash(hasher(key)));
+    }
 
-    // Hash function
-    size_t hash(const KeyType& key) const {
-        return std::hash<KeyType>{}(key) % capacity;
+    // Index of the node holding key (whose hash is h), or NIL
+    template <typename K>
+    uint32_t find(const K& key, size_t h) const {
+        for (uint32_t index = buckets[h & (capacity - 1)]; index != NIL; index = nodes[index].next) {
+            const Node& node = nodes[index];
+            if (node.hash == h && equal(node.key, key)) {
+                return index;
+            }
+        }
+        return NIL;
     }
 
-    // Resizes the table when the load factor exceeds the threshold
-    void resize() {
-        size_t newCapacity = capacity * 2;
-        std::vector<Bucket> newTable(newCapacity);
+    template <typename K>
+    bool removeKey(const K& key) {
+        size_t h = hash(key);
+        uint32_t* link = &buckets[h & (capacity - 1)];
+        while (*link != NIL) {
+            Node& node = nodes[*link];
+            if (node.hash == h && equal(node.key, key)) {
+                freeNodes.push_back(*link);
+                *link = node.next;
+                node.next = FREE;
+                // Free what the key and value own now instead of when an insert reuses the node
+                node.key = KeyType();
+                node.value = ValueType();
+                --size;
+                return true;
+            }
+            link = &node.next;
+        }
+        return false; // Key not found
+    }
 
-        for (const auto& bucket : table) {
-            for (const auto& pair : bucket) {
-                size_t newIndex = std::hash<KeyType>{}(pair.first) % newCapacity;
-                newTable[newIndex].emplace_back(pair);
+    // Moves to newCapacity buckets and relinks every live node into its new bucket
+    void resize(size_t newCapacity) {
+        std::vector<uint32_t> newBuckets(newCapacity, NIL);
+
+        for (uint32_t head : buckets) {
+            for (uint32_t index = head; index != NIL;) {
+                Node& node = nodes[index];
+                uint32_t next = node.next;
+                size_t newIndex = node.hash & (newCapacity - 1);
+                node.next = newBuckets[newIndex];
+                newBuckets[newIndex] = index;
+                index = next;
             }
         }
 
-        table = std::move(newTable);
+        buckets = std::move(newBuckets);
         capacity = newCapacity;
     }
 
+    static size_t roundCapacity(size_t requested) {
+        size_t rounded = 1;
+        while (rounded < requested) rounded *= 2;
+        return rounded;
+    }
+
 public:
-    // Constructor
+    // Constructor; the capacity is rounded up to a power of two
     explicit HashTable(size_t initialCapacity = 16, float loadFactorThreshold = 0.75f)
-        : capacity(initialCapacity), size(0), loadFactor(loadFactorThreshold) {
-        table.resize(capacity);
+        : capacity(roundCapacity(initialCapacity)), size(0), loadFactor(loadFactorThreshold) {
+        if (loadFactor <= 0.0f) {
+            throw std::invalid_argument("Load factor must be positive");
+        }
+        buckets.assign(capacity, NIL);
     }
 
     // Insert a key-value pair
     void insert(const KeyType& key, const ValueType& value) {
-        size_t index = hash(key);
-        for (auto& pair : table[index]) {
-            if (pair.first == key) {
-                pair.second = value; // Update value if key already exists
-                return;
+        size_t h = hash(key);
+        uint32_t existing = find(key, h);
+        if (existing != NIL) {
+            nodes[existing].value = value; // Update value if key already exists
+            return;
+        }
+
+        uint32_t index;
+        if (!freeNodes.empty()) {
+            index = freeNodes.back();
+            freeNodes.pop_back();
+            nodes[index].key = key;
+            nodes[index].value = value;
+            nodes[index].hash = h;
+        } else {
+            if (nodes.size() >= FREE) {
+                throw std::length_error("HashTable node pool is full");
             }
+            index = static_cast<uint32_t>(nodes.size());
+            nodes.push_back(Node{key, value, h, NIL});
         }
-        table[index].emplace_back(key, value);
+
+        size_t bucket = h & (capacity - 1);
+        nodes[index].next = buckets[bucket];
+        buckets[bucket] = index;
         ++size;
 
         if (static_cast<float>(size) / capacity > loadFactor) {
-            resize();
+            resize(capacity * 2);
         }
     }
 
-    // Retrieve a value by key
-    std::optional<ValueType> retrieve(const KeyType& key) const {
-        size_t index = hash(key);
-        for (const auto& pair : table[index]) {
-            if (pair.first == key) {
-                return pair.second;
-            }
+    // Sizes the buckets and node pool for count elements, so inserting up to that many
+    // triggers no resize
+    void reserve(size_t count) {
+        size_t needed = roundCapacity(static_cast<size_t>(std::ceil(count / static_cast<double>(loadFactor))));
+        if (needed > capacity) {
+            resize(needed);
+        }
+        if (count > nodes.size()) {
+            nodes.reserve(count);
         }
-        return std::nullopt;
     }
 
-    // Remove a key-value pair
-    bool remove(const KeyType& key) {
-        size_t index = hash(key);
-        if (index >= table.size()) {
-            std::cerr << "Error: Index " << index << " out of bounds for table size " << table.size() << "\n";
-            throw std::out_of_range("Hash index out of bounds");
+    // Inserts every (key, value) pair of a range, reserving space up front when the range
+    // length is known so the build hashes each key once and never resizes
+    template <typename Iterator>
+    void insertRange(Iterator first, Iterator last) {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>) {
+            reserve(size + static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            insert(first->first, first->second);
         }
+    }
 
-        auto& bucket = table[index];
-        for (auto it = bucket.begin(); it != bucket.end(); ++it) {
-            if (it->first == key) {
-                bucket.erase(it);
-                --size;
-                return true;
+    // Calls visitor(key, value) for every element, scanning the node pool in order
+    template <typename Visitor>
+    void forEach(Visitor visitor) const {
+        for (const Node& node : nodes) {
+            if (node.next != FREE) {
+                visitor(node.key, node.value);
             }
         }
-        return false; // Key not found
     }
 
+    // Retrieve a value by key
+    std::optional<ValueType> retrieve(const KeyType& key) const {
+        uint32_t index = find(key, hash(key));
+        if (index == NIL) {
+            return std::nullopt;
+        }
+        return nodes[index].value;
+    }
+
+    // Retrieve a value by any key type the transparent Hash and KeyEqual accept
+    template <typename K, typename H = Hash, typename = std::enable_if_t<IsTransparent<H, KeyEqual>::value>>
+    std::optional<ValueType> retrieve(const K& key) const {
+        uint32_t index = find(key, hash(key));
+        if (index == NIL) {
+            return std::nullopt;
+        }
+        return nodes[index].value;
+    }
+
+    // Remove a key-value pair
+    bool remove(const KeyType& key) {
+        return removeKey(key);
+    }
+
+    // Remove by any key type the transparent Hash and KeyEqual accept
+    template <typename K, typename H = Hash, typename = std::enable_if_t<IsTransparent<H, KeyEqual>::value>>
+    bool remove(const K& key) {
+        return removeKey(key);
+    }
 
     // Get the current size of the hash table
     size_t getSize() const {
@@ -102,4 +241,15 @@ public:
     size_t getCapacity() const {
         return capacity;
     }
-};
\ No newline at end of file
+
+    // Bytes held by the table's own arrays: buckets, node pool and free list. Heap memory owned
+    // by the keys and values themselves is not included.
+    size_t getMemoryUsage() const {
+        return buckets.capacity() * sizeof(uint32_t) + nodes.capacity() * sizeof(Node) +
+               freeNodes.capacity() * sizeof(uint32_t);
+    }
+};
+
+// Chaining table keyed by std::string that can be probed with std::string_view or const char*
+template <typename ValueType>
+using StringHashTable = HashTable<std::string, ValueType, StringHash, std::equal_to<>>;
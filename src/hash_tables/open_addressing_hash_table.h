@@ -3,120 +3,304 @@
 #include <vector>
 #include <optional>
 #include <stdexcept>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <cmath>
+#include "hash_mix.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OPEN_ADDRESSING_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Open addressing hash table in the Swiss table layout. Each slot has a 1-byte control tag in a
+// separate array: empty, deleted, or the low 7 bits of the key's hash. Lookups compare a whole
+// group of 16 tags against the hash fragment at once (one SSE2 compare where available), so
+// key/value memory is only touched for slots whose fragment matches, and a group containing an
+// empty tag ends the search. Capacity is a power of two so groups are picked with a mask.
 template <typename KeyType, typename ValueType>
 class OpenAddressingHashTable {
 private:
-    // Structure to represent a key-value pair and its state
+    // Structure to represent a key-value pair stored in a slot
     struct Entry {
         KeyType key;
         ValueType value;
-        bool isOccupied;    // Indicates if this slot is currently occupied
-        bool isDeleted;     // Indicates if this slot has been deleted
     };
 
-    std::vector<std::optional<Entry>> table; // Hash table storage
-    size_t capacity;                         // Total slots in the hash table
-    size_t size;                             // Current number of elements
-    float loadFactor;                        // Load factor threshold for resizing
+    static constexpr size_t GROUP_WIDTH = 16;
+    static constexpr int8_t EMPTY = -128;   // Never used since the last rehash; ends a probe
+    static constexpr int8_t DELETED = -2;   // Removed; probes continue past it
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    std::vector<int8_t> control;                // One tag per slot; full tags are 0..127
+    std::allocator<Entry> allocator;
+    Entry* slots;                               // Constructed only where the tag is full
+    size_t capacity;                            // Total slots in the hash table, a multiple of GROUP_WIDTH
+    size_t size;                                // Current number of elements
+    size_t deleted;                             // Slots holding a DELETED tag
+    float loadFactor;                           // Load factor threshold for resizing
+
+    static int8_t fragment(uint64_t h) { return static_cast<int8_t>(h & 0x7F); }
+
+    size_t groupMask() const { return capacity / GROUP_WIDTH - 1; }
 
-    // Hash function
-    size_t hash(const KeyType& key, size_t attempt = 0) const {
-        if (capacity == 0) {
-            throw std::logic_error("Hash table capacity is zero");
+    // Bit i is set when the i-th tag of the group starting at slot `first` equals tag
+    uint32_t matchTag(size_t first, int8_t tag) const {
+#if OPEN_ADDRESSING_SSE2
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control.data() + first));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(tag))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+            if (control[first + i] == tag) mask |= 1u << i;
         }
-        return (std::hash<KeyType>{}(key) + attempt) % capacity;
+        return mask;
+#endif
     }
 
-    // Resize the hash table when the load factor is exceeded
-    void resize() {
-        size_t newCapacity = capacity * 2;
-        std::vector<std::optional<Entry>> newTable(newCapacity);
+    // Bit i is set when the i-th tag of the group is EMPTY or DELETED (both have the sign bit set)
+    uint32_t matchFree(size_t first) const {
+#if OPEN_ADDRESSING_SSE2
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control.data() + first));
+        return static_cast<uint32_t>(_mm_movemask_epi8(group));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+            if (control[first + i] < 0) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    // Index of the lowest set bit of a non-zero mask
+    static size_t lowestBit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctz(mask));
+#else
+        size_t index = 0;
+        while (!(mask & 1u)) {
+            mask >>= 1;
+            ++index;
+        }
+        return index;
+#endif
+    }
 
-        for (const auto& entry : table) {
-            if (entry && entry->isOccupied && !entry->isDeleted) {
-                size_t attempt = 0;
-                size_t newIndex;
-                do {
-                    newIndex = (std::hash<KeyType>{}(entry->key) + attempt) % newCapacity;
-                    ++attempt;
-                } while (newTable[newIndex]);
+    // Slot holding key (whose hash is h), or NOT_FOUND. Groups are visited in triangular order (offsets 1, 3, 6, ...),
+    // which reaches every group when the group count is a power of two.
+    size_t find(const KeyType& key, uint64_t h) const {
+        const int8_t tag = fragment(h);
+        size_t group = static_cast<size_t>(h >> 7) & groupMask();
 
-                newTable[newIndex] = entry;
+        for (size_t probe = 1; probe <= capacity / GROUP_WIDTH; ++probe) {
+            const size_t first = group * GROUP_WIDTH;
+            for (uint32_t matches = matchTag(first, tag); matches != 0; matches &= matches - 1) {
+                size_t index = first + lowestBit(matches);
+                if (slots[index].key == key) return index;
             }
+            if (matchTag(first, EMPTY) != 0) return NOT_FOUND;
+            group = (group + probe) & groupMask();
+        }
+        return NOT_FOUND;
+    }
+
+    // First EMPTY or DELETED slot on the probe sequence of hash h
+    size_t findFreeSlot(uint64_t h) const {
+        size_t group = static_cast<size_t>(h >> 7) & groupMask();
+        for (size_t probe = 1; ; ++probe) {
+            const size_t first = group * GROUP_WIDTH;
+            uint32_t free = matchFree(first);
+            if (free != 0) return first + lowestBit(free);
+            group = (group + probe) & groupMask();
         }
+    }
+
+    // Moves every element into freshly allocated arrays of newCapacity slots, dropping tombstones
+    void rehash(size_t newCapacity) {
+        std::vector<int8_t> oldControl = std::move(control);
+        control.assign(newCapacity, EMPTY);
+        Entry* oldSlots = slots;
+        size_t oldCapacity = capacity;
 
-        table = std::move(newTable);
+        slots = allocator.allocate(newCapacity);
         capacity = newCapacity;
+        deleted = 0;
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldControl[i] >= 0) {
+                uint64_t h = hash(oldSlots[i].key);
+                size_t index = findFreeSlot(h);
+                control[index] = fragment(h);
+                new (slots + index) Entry{std::move(oldSlots[i].key), std::move(oldSlots[i].value)};
+                oldSlots[i].~Entry();
+            }
+        }
+        if (oldSlots) allocator.deallocate(oldSlots, oldCapacity);
+    }
+
+    // Resize the hash table when the load factor is exceeded. Mostly-tombstone tables are
+    // cleaned at the same capacity instead of doubling.
+    void reserveOneMore() {
+        if (static_cast<float>(size + deleted + 1) <= capacity * loadFactor) return;
+        rehash(deleted > size / 2 ? capacity : capacity * 2);
+    }
+
+    static size_t roundCapacity(size_t requested) {
+        size_t rounded = GROUP_WIDTH;
+        while (rounded < requested) rounded *= 2;
+        return rounded;
     }
 
+    void destroyAll() {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (control[i] >= 0) slots[i].~Entry();
+        }
+        if (slots) allocator.deallocate(slots, capacity);
+        slots = nullptr;
+    }
 
 public:
-    // Constructor
-    explicit OpenAddressingHashTable(size_t initialCapacity = 16, float loadFactorThreshold = 0.75f)
-        : capacity(initialCapacity), size(0), loadFactor(loadFactorThreshold) {
-        table.resize(capacity);
+    // Hash of a key as the table uses it; the 7-bit fragment comes from the low bits and the group
+    // index from the bits above them. Callers that already need the hash, such as ConcurrentHashMap
+    // picking a segment, pass it to the overloads taking h so the key is hashed only once.
+    static uint64_t hash(const KeyType& key) {
+        return mixHash(std::hash<KeyType>{}(key));
+    }
+
+    // Constructor; the capacity is rounded up to a power of two of at least one group
+    explicit OpenAddressingHashTable(size_t initialCapacity = 16, float loadFactorThreshold = 0.875f)
+        : slots(nullptr), capacity(roundCapacity(initialCapacity)), size(0), deleted(0), loadFactor(loadFactorThreshold) {
+        if (loadFactor <= 0.0f || loadFactor > 1.0f) {
+            throw std::invalid_argument("Load factor must be in (0, 1]");
+        }
+        control.assign(capacity, EMPTY);
+        slots = allocator.allocate(capacity);
+    }
+
+    OpenAddressingHashTable(const OpenAddressingHashTable& other)
+        : control(other.control), slots(nullptr), capacity(other.capacity), size(other.size),
+          deleted(other.deleted), loadFactor(other.loadFactor) {
+        slots = allocator.allocate(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            if (control[i] >= 0) new (slots + i) Entry(other.slots[i]);
+        }
+    }
+
+    OpenAddressingHashTable& operator=(OpenAddressingHashTable other) {
+        std::swap(control, other.control);
+        std::swap(slots, other.slots);
+        std::swap(capacity, other.capacity);
+        std::swap(size, other.size);
+        std::swap(deleted, other.deleted);
+        std::swap(loadFactor, other.loadFactor);
+        return *this;
+    }
+
+    ~OpenAddressingHashTable() {
+        destroyAll();
     }
 
     // Insert a key-value pair
     void insert(const KeyType& key, const ValueType& value) {
-        if (static_cast<float>(size) / capacity > loadFactor) {
-            resize();
-        }
-
-        size_t attempt = 0;
-        size_t index;
-
-        do {
-            index = hash(key, attempt++);
-            if (!table[index] || table[index]->isDeleted) {
-                table[index] = Entry{key, value, true, false};
-                ++size;
-                return;
-            } else if (table[index]->key == key) {
-                table[index]->value = value; // Update value if key exists
-                return;
-            }
-        } while (attempt < capacity);
+        insert(key, value, hash(key));
+    }
+
+    // Insert a key-value pair whose hash(key) is h
+    void insert(const KeyType& key, const ValueType& value, uint64_t h) {
+        size_t existing = find(key, h);
+        if (existing != NOT_FOUND) {
+            slots[existing].value = value; // Update value if key exists
+            return;
+        }
+
+        reserveOneMore();
+        size_t index = findFreeSlot(h);
+        if (control[index] == DELETED) --deleted;
+        control[index] = fragment(h);
+        new (slots + index) Entry{key, value};
+        ++size;
+    }
 
-        throw std::runtime_error("Hash table is full");
+    // Sizes the table for count elements, so inserting up to that many triggers no rehash
+    void reserve(size_t count) {
+        size_t needed = roundCapacity(static_cast<size_t>(std::ceil(count / static_cast<double>(loadFactor))));
+        if (needed > capacity) {
+            rehash(needed);
+        }
+    }
+
+    // Inserts every (key, value) pair of a range, reserving space up front when the range
+    // length is known so the build hashes each key once and never rehashes
+    template <typename Iterator>
+    void insertRange(Iterator first, Iterator last) {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>) {
+            reserve(size + deleted + static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            insert(first->first, first->second);
+        }
+    }
+
+    // Calls visitor(key, value) for every element, scanning the slots in order
+    template <typename Visitor>
+    void forEach(Visitor visitor) const {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (control[i] >= 0) {
+                visitor(slots[i].key, slots[i].value);
+            }
+        }
     }
 
     // Retrieve a value by key
     std::optional<ValueType> retrieve(const KeyType& key) const {
-        size_t attempt = 0;
-        size_t index;
-
-        do {
-            index = hash(key, attempt++);
-            if (!table[index]) {
-                return std::nullopt; // Key not found
-            } else if (table[index]->isOccupied && !table[index]->isDeleted && table[index]->key == key) {
-                return table[index]->value;
-            }
-        } while (attempt < capacity);
+        return retrieve(key, hash(key));
+    }
+
+    std::optional<ValueType> retrieve(const KeyType& key, uint64_t h) const {
+        size_t index = find(key, h);
+        if (index == NOT_FOUND) {
+            return std::nullopt; // Key not found
+        }
+        return slots[index].value;
+    }
+
+    // Pointer to the stored value, or nullptr if the key is absent; valid until the table next changes
+    const ValueType* lookup(const KeyType& key) const {
+        return lookup(key, hash(key));
+    }
 
-        return std::nullopt; // Key not found
+    const ValueType* lookup(const KeyType& key, uint64_t h) const {
+        size_t index = find(key, h);
+        return index == NOT_FOUND ? nullptr : &slots[index].value;
     }
 
     // Remove a key-value pair
     bool remove(const KeyType& key) {
-        size_t attempt = 0;
-        size_t index;
-
-        do {
-            index = hash(key, attempt++);
-            if (!table[index]) {
-                return false; // Key not found
-            } else if (table[index]->isOccupied && !table[index]->isDeleted && table[index]->key == key) {
-                table[index]->isDeleted = true;
-                table[index]->isOccupied = false; // Mark slot as no longer occupied
-                --size;
-                return true;
-            }
-        } while (attempt < capacity);
+        return remove(key, hash(key));
+    }
+
+    bool remove(const KeyType& key, uint64_t h) {
+        size_t index = find(key, h);
+        if (index == NOT_FOUND) {
+            return false; // Key not found
+        }
 
-        return false; // Key not found
+        // A group that still has an EMPTY tag has never been full, so no probe ever continued past
+        // it and the slot can go straight back to EMPTY; otherwise it must stay a tombstone.
+        size_t first = index - index % GROUP_WIDTH;
+        if (matchTag(first, EMPTY) != 0) {
+            control[index] = EMPTY;
+        } else {
+            control[index] = DELETED;
+            ++deleted;
+        }
+        slots[index].~Entry();
+        --size;
+        return true;
     }
 
     // Get the current size of the hash table
@@ -128,4 +312,10 @@ public:
     size_t getCapacity() const {
         return capacity;
     }
-};
\ No newline at end of file
+
+    // Bytes held by the table's own arrays: the slots and their control bytes. Heap memory owned
+    // by the keys and values themselves is not included.
+    size_t getMemoryUsage() const {
+        return capacity * sizeof(Entry) + control.capacity() * sizeof(int8_t);
+    }
+};
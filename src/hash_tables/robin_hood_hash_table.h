@@ -0,0 +1,297 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <cmath>
+#include "hash_mix.h"
+
+// Open addressing hash table with Robin Hood insertion and backward-shift deletion. Every slot
+// records how far its entry sits from its home slot; an insert takes the slot of any entry that
+// is closer to home than the one being placed, which keeps probe lengths short and even. Lookups
+// stop as soon as they reach an entry closer to home than the probe, and removal shifts the
+// following entries back one slot instead of leaving a tombstone, so churn never degrades probes.
+template <typename KeyType, typename ValueType>
+class RobinHoodHashTable {
+private:
+    // Structure to represent a key-value pair stored in a slot
+    struct Entry {
+        KeyType key;
+        ValueType value;
+    };
+
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+    static constexpr uint8_t MAX_DISTANCE = 254;    // Largest probe distance before the table grows
+
+    std::vector<uint8_t> distances;     // 0 for an empty slot, otherwise 1 + distance from home
+    std::allocator<Entry> allocator;
+    Entry* slots;                       // Constructed only where the distance is non-zero
+    size_t capacity;                    // Total slots in the hash table, a power of two
+    size_t size;                        // Current number of elements
+    float loadFactor;                   // Load factor threshold for resizing
+
+    static uint64_t hash(const KeyType& key) {
+        return mixHash(std::hash<KeyType>{}(key));
+    }
+
+    size_t home(const KeyType& key) const {
+        return static_cast<size_t>(hash(key)) & (capacity - 1);
+    }
+
+    size_t find(const KeyType& key) const {
+        size_t index = home(key);
+        for (size_t distance = 1; ; ++distance) {
+            // An empty slot or an entry closer to its home than this probe means the key is absent
+            if (distances[index] < distance) return NOT_FOUND;
+            if (distances[index] == distance && slots[index].key == key) return index;
+            index = (index + 1) & (capacity - 1);
+        }
+    }
+
+    // Places an entry known to be absent, starting the probe `distance` slots from its home at
+    // index. If some entry would end up more than MAX_DISTANCE slots from home, returns false
+    // and hands that entry back through `entry` for a retry after growing.
+    bool place(Entry&& entry, size_t index, size_t distance) {
+        Entry carried = std::move(entry);
+
+        while (true) {
+            if (distance > MAX_DISTANCE) {
+                entry = std::move(carried);
+                return false;
+            }
+            if (distances[index] == 0) {
+                new (slots + index) Entry(std::move(carried));
+                distances[index] = static_cast<uint8_t>(distance);
+                ++size;
+                return true;
+            }
+            if (distances[index] < distance) {
+                // Take the slot from the entry that is closer to home and carry that one onward
+                std::swap(carried, slots[index]);
+                uint8_t displaced = distances[index];
+                distances[index] = static_cast<uint8_t>(distance);
+                distance = displaced;
+            }
+            index = (index + 1) & (capacity - 1);
+            ++distance;
+        }
+    }
+
+    // Number of stored entries whose full hash equals that of key. They all share one home slot
+    // and sit in the MAX_DISTANCE slots from it, at the probe distance of their position.
+    size_t countSharedHash(const KeyType& key) const {
+        uint64_t h = hash(key);
+        size_t index = static_cast<size_t>(h) & (capacity - 1);
+        size_t shared = 0;
+        for (size_t distance = 1; distance <= MAX_DISTANCE; ++distance) {
+            if (distances[index] == distance && hash(slots[index].key) == h) ++shared;
+            index = (index + 1) & (capacity - 1);
+        }
+        return shared;
+    }
+
+    bool place(Entry&& entry) {
+        return place(std::move(entry), home(entry.key), 1);
+    }
+
+    void rehash(size_t newCapacity) {
+        std::vector<uint8_t> oldDistances = std::move(distances);
+        Entry* oldSlots = slots;
+        size_t oldCapacity = capacity;
+
+        distances.assign(newCapacity, 0);
+        slots = allocator.allocate(newCapacity);
+        capacity = newCapacity;
+        size = 0;
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldDistances[i] != 0) {
+                Entry entry = std::move(oldSlots[i]);
+                oldSlots[i].~Entry();
+                // Pathological clustering; grow again and retry. This ends because insert() never
+                // admits more than MAX_DISTANCE keys with one full hash, which growing cannot separate.
+                while (!place(std::move(entry))) {
+                    rehash(capacity * 2);
+                }
+            }
+        }
+        if (oldSlots) allocator.deallocate(oldSlots, oldCapacity);
+    }
+
+    static size_t roundCapacity(size_t requested) {
+        size_t rounded = 16;
+        while (rounded < requested) rounded *= 2;
+        return rounded;
+    }
+
+public:
+    // Probe length summary; a probe length is 1 for an entry in its home slot
+    struct ProbeStatistics {
+        size_t maxProbeLength;
+        double averageProbeLength;
+    };
+
+    // Constructor; the capacity is rounded up to a power of two
+    explicit RobinHoodHashTable(size_t initialCapacity = 16, float loadFactorThreshold = 0.9f)
+        : slots(nullptr), capacity(roundCapacity(initialCapacity)), size(0), loadFactor(loadFactorThreshold) {
+        if (loadFactor <= 0.0f || loadFactor >= 1.0f) {
+            throw std::invalid_argument("Load factor must be in (0, 1)");
+        }
+        distances.assign(capacity, 0);
+        slots = allocator.allocate(capacity);
+    }
+
+    RobinHoodHashTable(const RobinHoodHashTable& other)
+        : distances(other.distances), slots(nullptr), capacity(other.capacity), size(other.size), loadFactor(other.loadFactor) {
+        slots = allocator.allocate(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            if (distances[i] != 0) new (slots + i) Entry(other.slots[i]);
+        }
+    }
+
+    RobinHoodHashTable& operator=(RobinHoodHashTable other) {
+        std::swap(distances, other.distances);
+        std::swap(slots, other.slots);
+        std::swap(capacity, other.capacity);
+        std::swap(size, other.size);
+        std::swap(loadFactor, other.loadFactor);
+        return *this;
+    }
+
+    ~RobinHoodHashTable() {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (distances[i] != 0) slots[i].~Entry();
+        }
+        if (slots) allocator.deallocate(slots, capacity);
+    }
+
+    // Insert a key-value pair. The lookup and the placement share one probe: the key is absent
+    // once the probe reaches a slot whose entry is closer to home, and that is where it goes.
+    // Throws std::length_error, leaving the table unchanged, if MAX_DISTANCE stored keys already
+    // have the same full hash as key, since no capacity could give one more a slot.
+    void insert(const KeyType& key, const ValueType& value) {
+        if (static_cast<float>(size + 1) > capacity * loadFactor) {
+            rehash(capacity * 2);
+        }
+
+        size_t index = home(key);
+        size_t distance = 1;
+        size_t sameHome = 0;
+        for (; distances[index] >= distance; ++distance) {
+            if (distances[index] == distance) {
+                if (slots[index].key == key) {
+                    slots[index].value = value; // Update value if key exists
+                    return;
+                }
+                ++sameHome;
+            }
+            index = (index + 1) & (capacity - 1);
+        }
+        if (sameHome >= MAX_DISTANCE && countSharedHash(key) >= MAX_DISTANCE) {
+            throw std::length_error("Too many keys share one hash value");
+        }
+
+        Entry entry{key, value};
+        if (!place(std::move(entry), index, distance)) {
+            do {
+                rehash(capacity * 2);   // Ends, since the check above keeps every shared-hash group placeable
+            } while (!place(std::move(entry)));
+        }
+    }
+
+    // Sizes the table for count elements, so inserting up to that many triggers no rehash
+    void reserve(size_t count) {
+        size_t needed = roundCapacity(static_cast<size_t>(std::ceil(count / static_cast<double>(loadFactor))));
+        if (needed > capacity) {
+            rehash(needed);
+        }
+    }
+
+    // Inserts every (key, value) pair of a range, reserving space up front when the range
+    // length is known so the build never rehashes
+    template <typename Iterator>
+    void insertRange(Iterator first, Iterator last) {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>) {
+            reserve(size + static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            insert(first->first, first->second);
+        }
+    }
+
+    // Calls visitor(key, value) for every element, scanning the slots in order
+    template <typename Visitor>
+    void forEach(Visitor visitor) const {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (distances[i] != 0) {
+                visitor(slots[i].key, slots[i].value);
+            }
+        }
+    }
+
+    // Retrieve a value by key
+    std::optional<ValueType> retrieve(const KeyType& key) const {
+        size_t index = find(key);
+        if (index == NOT_FOUND) {
+            return std::nullopt; // Key not found
+        }
+        return slots[index].value;
+    }
+
+    // Remove a key-value pair, shifting the entries after it back toward their homes
+    bool remove(const KeyType& key) {
+        size_t index = find(key);
+        if (index == NOT_FOUND) {
+            return false; // Key not found
+        }
+
+        size_t next = (index + 1) & (capacity - 1);
+        while (distances[next] > 1) {
+            slots[index] = std::move(slots[next]);
+            distances[index] = distances[next] - 1;
+            index = next;
+            next = (next + 1) & (capacity - 1);
+        }
+        slots[index].~Entry();
+        distances[index] = 0;
+        --size;
+        return true;
+    }
+
+    // Longest and mean probe length over the stored entries
+    ProbeStatistics getProbeStatistics() const {
+        ProbeStatistics statistics{0, 0.0};
+        size_t total = 0;
+        for (uint8_t distance : distances) {
+            if (distance != 0) {
+                statistics.maxProbeLength = std::max<size_t>(statistics.maxProbeLength, distance);
+                total += distance;
+            }
+        }
+        statistics.averageProbeLength = size == 0 ? 0.0 : static_cast<double>(total) / size;
+        return statistics;
+    }
+
+    // Get the current size of the hash table
+    size_t getSize() const {
+        return size;
+    }
+
+    // Get the capacity of the hash table
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    // Bytes held by the table's own arrays: the slots and their probe distances. Heap memory
+    // owned by the keys and values themselves is not included.
+    size_t getMemoryUsage() const {
+        return capacity * sizeof(Entry) + distances.capacity() * sizeof(uint8_t);
+    }
+};
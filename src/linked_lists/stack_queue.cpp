@@ -1,21 +1,35 @@
 #include "stack_queue.h"
 #include <iostream>
 
+// Allocates a node from pool, or from the heap when pool is null
+static Node* createNode(NodePool<Node>* pool, int value) {
+    return pool ? pool->allocate(value) : new Node(value);
+}
+
+// Frees a node created by createNode with the same pool
+static void destroyNode(NodePool<Node>* pool, Node* node) {
+    if (pool) {
+        pool->deallocate(node);
+    } else {
+        delete node;
+    }
+}
+
 // Constructor
-Stack::Stack() : top(nullptr), size(0) {}
+Stack::Stack(NodePool<Node>* pool) : top(nullptr), size(0), pool(pool) {}
 
 // Destructor
 Stack::~Stack() {
     while (top) {
         Node* temp = top;
         top = top->prev; // Move to the previous node
-        delete temp;     // Free the current node
+        destroyNode(pool, temp); // Free the current node
     }
 }
 
 // Insert a value onto the stack
 void Stack::Insert(int value) {
-    Node* newNode = new Node(value);
+    Node* newNode = createNode(pool, value);
     newNode->prev = top;  // Link the new node to the current top
     top = newNode;        // Update the top pointer
     ++size;
@@ -29,7 +43,7 @@ int Stack::Remove() {
     int value = top->data; // Retrieve the value from the top
     Node* temp = top;      // Store the current top
     top = top->prev;       // Move the top pointer to the previous node
-    delete temp;           // Delete the old top node
+    destroyNode(pool, temp); // Delete the old top node
     --size;
     return value;
 }
@@ -48,20 +62,20 @@ void Stack::Print() const {
 
 
 // Constructor
-Queue::Queue() : front(nullptr), rear(nullptr), size(0) {}
+Queue::Queue(NodePool<Node>* pool) : front(nullptr), rear(nullptr), size(0), pool(pool) {}
 
 // Destructor
 Queue::~Queue() {
     while (front) {
         Node* temp = front;
         front = front->next; // Move to the next node
-        delete temp;         // Free the current node
+        destroyNode(pool, temp); // Free the current node
     }
 }
 
 // Insert a value at the rear of the queue
 void Queue::Insert(int value) {
-    Node* newNode = new Node(value);
+    Node* newNode = createNode(pool, value);
     if (!rear) {                    // If the queue is empty
         front = rear = newNode;     // Front and rear point to the new node
     } else {
@@ -85,7 +99,7 @@ int Queue::Remove() {
     } else {
         rear = nullptr;        // If the queue becomes empty, reset the rear pointer
     }
-    delete temp;
+    destroyNode(pool, temp);
     --size;
     return value;
 }
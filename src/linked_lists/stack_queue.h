@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include "../memory/node_pool.h"
 
 // Node structure for the doubly-linked list
 class Node {
@@ -13,15 +14,17 @@ public:
     explicit Node(int value) : data(value), next(nullptr), prev(nullptr) {}
 };
 
-// Stack class using a doubly-linked list
+// Stack class using a doubly-linked list. Nodes come from the heap, or from pool when one is
+// given; the pool must outlive the stack and may be shared with other containers.
 class Stack {
 private:
     Node* top;
     int size;
+    NodePool<Node>* pool;
 
 public:
     // Constructor: initializes an empty stack
-    Stack();
+    explicit Stack(NodePool<Node>* pool = nullptr);
 
     // Destructor: cleans up dynamically allocated memory
     ~Stack();
@@ -36,16 +39,17 @@ public:
     int getSize() const noexcept { return size; }
 };
 
-// Queue class using a doubly-linked list
+// Queue class using a doubly-linked list, allocating nodes like Stack
 class Queue {
 private:
     Node* front;
     Node* rear;
     int size;
+    NodePool<Node>* pool;
 
 public:
     // Constructor: initializes an empty queue
-    Queue();
+    explicit Queue(NodePool<Node>* pool = nullptr);
 
     // Destructor: cleans up dynamically allocated memory
     ~Queue();
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Fixed-size allocator for the nodes of linked containers. Nodes are carved out of large blocks,
+// so an allocation is a pointer bump or a pop from the free list instead of a trip through the
+// general heap, and neighbouring nodes share cache lines. deallocate() puts a node on the free
+// list for the next allocate(); reset() forgets every node at once and keeps the blocks for
+// reuse, and release() hands the blocks back to the heap. Neither reset() nor release() runs
+// destructors, so nodes with non-trivial destructors must be deallocated individually first.
+template <typename T>
+class NodePool {
+private:
+    // A slot holds either a live node or the link to the next free slot
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> blocks;
+    size_t nodesPerBlock;
+    size_t currentBlock;    // Block the bump pointer is in; blocks after it are unused
+    size_t nextSlot;        // Next never-used slot of the current block
+    Slot* freeList;         // Slots returned by deallocate, reused last in first out
+    size_t liveCount;       // Nodes allocated and not yet returned
+
+public:
+    // Constructor; each block holds nodesPerBlock nodes
+    explicit NodePool(size_t nodesPerBlock = 1024)
+        : nodesPerBlock(nodesPerBlock), currentBlock(0), nextSlot(0), freeList(nullptr), liveCount(0) {
+        if (nodesPerBlock == 0) {
+            throw std::invalid_argument("Nodes per block must be positive");
+        }
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    // Constructs a node from args in a free slot
+    template <typename... Args>
+    T* allocate(Args&&... args) {
+        Slot* slot;
+        if (freeList) {
+            slot = freeList;
+            freeList = freeList->next;
+        } else {
+            if (currentBlock == blocks.size() || nextSlot == nodesPerBlock) {
+                if (currentBlock < blocks.size()) {
+                    ++currentBlock;     // Move on to the next block, reusing it if reset() left one
+                }
+                if (currentBlock == blocks.size()) {
+                    blocks.emplace_back(new Slot[nodesPerBlock]);
+                }
+                nextSlot = 0;
+            }
+            slot = &blocks[currentBlock][nextSlot++];
+        }
+
+        T* node = new (slot->storage) T(std::forward<Args>(args)...);
+        ++liveCount;
+        return node;
+    }
+
+    // Destroys a node and makes its slot available to the next allocate()
+    void deallocate(T* node) {
+        node->~T();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->next = freeList;
+        freeList = slot;
+        --liveCount;
+    }
+
+    // Discards every node at once, keeping the blocks for later allocations
+    void reset() {
+        currentBlock = 0;
+        nextSlot = 0;
+        freeList = nullptr;
+        liveCount = 0;
+    }
+
+    // Discards every node and returns all blocks to the heap
+    void release() {
+        blocks.clear();
+        reset();
+    }
+
+    // Get the number of nodes currently allocated
+    size_t getLiveCount() const {
+        return liveCount;
+    }
+
+    // Get the number of nodes the allocated blocks can hold
+    size_t getCapacity() const {
+        return blocks.size() * nodesPerBlock;
+    }
+};
@@ -1,8 +1,16 @@
 #include "menu_actions.h"
 #include "../core/functions.h"
 #include "../sorting/sorting_analysis.h"
+#include "../screener/screen_rules.h"
+#include "../database/database_utils.h"
+#include "../core/symbol_table.h"
+#include "../backtest/backtester.h"
 #include <iostream>
+#include <iomanip>
 #include <deque>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 namespace MenuActions {
 
@@ -18,27 +26,36 @@ namespace MenuActions {
             std::cout << "1. Get Stock Ticker Data\n";
             std::cout << "2. Calculate Average Stock Price\n";
             std::cout << "3. Check Threshold\n";
-            std::cout << "4. Back to Main Menu\n";
+            std::cout << "4. Run Screening Rule\n";
+            std::cout << "5. Window Statistics\n";
+            std::cout << "6. Screen and Rank Stored Tickers\n";
+            std::cout << "7. Back to Main Menu\n";
         } else if (menuLevel == 3) {
             std::cout << "Threshold and Window Settings:\n";
             std::cout << "1. Modify Threshold Setting (Current: " << threshold << "%)\n";
             std::cout << "2. Apply Sliding Window\n";
             std::cout << "3. Modify Sliding Window Size (Current: " << windowSize << ")\n";
             std::cout << "4. Detect Momentum\n";
-            std::cout << "5. Back to Main Menu\n";
+            std::cout << "5. Rolling Median and Percentile\n";
+            std::cout << "6. Backtest Threshold and Window Sizes\n";
+            std::cout << "7. Back to Main Menu\n";
         } else if (menuLevel == 4) {
             std::cout << "Sorting Analysis:\n";
             std::cout << "1. Run Sorting Analysis (On Random data)\n";
-            std::cout << "2. Back to Main Menu\n";
+            std::cout << "2. Run Sorting Benchmark (All Input Shapes)\n";
+            std::cout << "3. Back to Main Menu\n";
         }
         std::cout << "Select an option: ";
     }
 
-    void getStockData(std::vector<double>& stockPrices, const std::string& timeframe) {
-        std::string ticker;
+    void getStockData(std::vector<double>& stockPrices, StockScanner::RangeIndex& priceIndex,
+                      StockScanner::SymbolTable& symbols, StockScanner::SymbolId& ticker, StockScanner::SymbolId timeframe) {
+        std::string name;
         std::cout << "Enter stock ticker: ";
-        std::cin >> ticker;
-        stockPrices = StockScanner::loadStockData(ticker, timeframe);
+        std::cin >> name;
+        ticker = symbols.intern(name);
+        stockPrices = StockScanner::loadStockData(symbols, ticker, timeframe);
+        priceIndex.build(stockPrices);  // Index once so window statistics never rescan the prices
 
         if (!stockPrices.empty()) {
             std::cout << "Stock data loaded successfully.\n\n";
@@ -66,6 +83,86 @@ namespace MenuActions {
         }
     }
 
+    void runScreen(const std::vector<double>& stockPrices) {
+        if (stockPrices.empty()) {
+            std::cout << "No stock data available. Please load stock data first.\n";
+            return;
+        }
+
+        std::string expression;
+        std::cout << "Enter screening rule (e.g. pct_change(20) > 5 and sma(5) > sma(20) and up_run(3)): ";
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::getline(std::cin, expression);
+
+        try {
+            StockScanner::ScreenRule rule(expression);
+            bool result = rule.evaluate(stockPrices);
+            std::cout << (result ? "The stock matches the screening rule.\n\n"
+                                 : "The stock does not match the screening rule.\n\n");
+        } catch (const std::invalid_argument& e) {
+            std::cout << e.what() << "\n\n";
+        }
+    }
+
+    void rankStoredTickers(StockScanner::SymbolTable& symbols) {
+        std::string expression;
+        size_t count;
+        std::cout << "Enter screening rule (e.g. pct_change(20) > 5 and sma(5) > sma(20) and up_run(3)): ";
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::getline(std::cin, expression);
+        std::cout << "Number of tickers to list: ";
+        std::cin >> count;
+        if (!std::cin) {
+            std::cout << "Invalid count.\n\n";
+            return;
+        }
+
+        // Tickers become dense IDs on load; names are looked up again only for display
+        std::vector<std::vector<double>> universe = StockScanner::getAllStockSeriesFromDatabase(symbols);
+        if (universe.empty()) {
+            std::cout << "No stock data stored. Please load stock data first.\n\n";
+            return;
+        }
+
+        try {
+            StockScanner::ScreenRule rule(expression);
+            std::vector<ScanRecord> ranked = StockScanner::rankUniverse(rule, universe, count);
+            if (ranked.empty()) {
+                std::cout << "No stored ticker matches the screening rule.\n\n";
+                return;
+            }
+
+            std::cout << std::setw(4) << "Rank" << " | " << std::setw(8) << "Ticker" << " | " << std::setw(10) << "Change %" << "\n";
+            for (size_t i = 0; i < ranked.size(); ++i) {
+                std::cout << std::setw(4) << i + 1 << " | " << std::setw(8) << symbols.name(ranked[i].symbol)
+                          << " | " << std::setw(10) << ranked[i].metric << "\n";
+            }
+            std::cout << "\n";
+        } catch (const std::invalid_argument& e) {
+            std::cout << e.what() << "\n\n";
+        }
+    }
+
+    void windowStatistics(const StockScanner::RangeIndex& priceIndex) {
+        if (priceIndex.empty()) {
+            std::cout << "No stock data available. Please load stock data first.\n";
+            return;
+        }
+
+        size_t start, length;
+        std::cout << "Enter window start (0-" << priceIndex.size() - 1 << ") and length: ";
+        std::cin >> start >> length;
+
+        try {
+            std::cout << "Mean: " << priceIndex.mean(start, length)
+                      << ", Variance: " << priceIndex.variance(start, length)
+                      << ", Min: " << priceIndex.minimum(start, length)
+                      << ", Max: " << priceIndex.maximum(start, length) << "\n\n";
+        } catch (const std::out_of_range&) {
+            std::cout << "Window must lie within the " << priceIndex.size() << " loaded prices.\n\n";
+        }
+    }
+
     void modifyThreshold(double& threshold) {
         std::cout << "Enter new threshold percentage: ";
         std::cin >> threshold;
@@ -105,12 +202,88 @@ namespace MenuActions {
         }
     }
 
-    void changeTimeframe(std::string& timeframe) {
+    void rollingMedian(const std::vector<double>& stockPrices, size_t windowSize) {
+        if (stockPrices.empty()) {
+            std::cout << "No stock data available. Please load stock data first.\n";
+            return;
+        }
+        if (windowSize == 0 || windowSize > stockPrices.size()) {
+            std::cout << "Sliding window size must be between 1 and " << stockPrices.size() << ".\n";
+            return;
+        }
+
+        double percentile;
+        std::cout << "Enter percentile (0-100, 50 for the median): ";
+        std::cin >> percentile;
+
+        std::vector<double> values = StockScanner::calculateRollingPercentile(stockPrices, windowSize, percentile);
+        std::cout << "Rolling " << percentile << "th percentile (window " << windowSize << "): ";
+        for (double value : values) {
+            std::cout << value << " ";
+        }
+        std::cout << "\n\n";
+    }
+
+    void backtestParameters(const std::vector<double>& stockPrices, StockScanner::SymbolId ticker) {
+        if (stockPrices.empty()) {
+            std::cout << "No stock data available. Please load stock data first.\n";
+            return;
+        }
+
+        double minThreshold, maxThreshold, thresholdStep;
+        size_t minWindow, maxWindow, holdingPeriod;
+        std::cout << "Enter threshold range (min max step): ";
+        std::cin >> minThreshold >> maxThreshold >> thresholdStep;
+        std::cout << "Enter window size range (min max): ";
+        std::cin >> minWindow >> maxWindow;
+        std::cout << "Enter holding period in bars: ";
+        std::cin >> holdingPeriod;
+
+        if (!std::cin || thresholdStep <= 0.0 || minThreshold > maxThreshold || minWindow > maxWindow) {
+            std::cout << "Invalid parameter ranges.\n";
+            return;
+        }
+
+        std::vector<double> thresholds;
+        for (double t = minThreshold; t <= maxThreshold + 1e-9; t += thresholdStep) {
+            thresholds.push_back(t);
+        }
+        std::vector<size_t> windowSizes;
+        for (size_t w = minWindow; w <= maxWindow; ++w) {
+            windowSizes.push_back(w);
+        }
+
+        // The universe is indexed by SymbolId; only the loaded ticker has prices
+        std::vector<std::vector<double>> universe(ticker + 1);
+        universe[ticker] = stockPrices;
+        std::vector<StockScanner::BacktestResult> results =
+            StockScanner::runParameterSweep(universe, thresholds, windowSizes, holdingPeriod);
+        std::sort(results.begin(), results.end(), [](const auto& a, const auto& b) {
+            return a.averageReturnPercent > b.averageReturnPercent;
+        });
+
+        std::cout << std::setw(10) << "Threshold" << " | " << std::setw(6) << "Window"
+                  << " | " << std::setw(6) << "Trades" << " | " << std::setw(6) << "Wins"
+                  << " | " << std::setw(12) << "Avg Return %" << "\n";
+        for (const auto& result : results) {
+            std::cout << std::setw(10) << result.parameters.threshold
+                      << " | " << std::setw(6) << result.parameters.windowSize
+                      << " | " << std::setw(6) << result.trades.size()
+                      << " | " << std::setw(6) << result.wins
+                      << " | " << std::setw(12) << result.averageReturnPercent << "\n";
+        }
+        std::cout << "\n";
+    }
+
+    void changeTimeframe(StockScanner::SymbolId& timeframe) {
+        std::string name;
         std::cout << "Enter timeframe (options: 5min, 15min, daily, hourly): ";
-        std::cin >> timeframe;
-        if (StockScanner::timeframeMap.find(timeframe) == StockScanner::timeframeMap.end()) {
+        std::cin >> name;
+        if (std::optional<StockScanner::SymbolId> id = StockScanner::timeframeSymbols().find(name)) {
+            timeframe = *id;
+        } else {
             std::cout << "Invalid timeframe. Setting to default ('daily').\n";
-            timeframe = "daily";
+            timeframe = StockScanner::defaultTimeframe();
         }
     }
 }
@@ -3,15 +3,23 @@
 #include <vector>
 #include <string>
 #include <deque>
+#include "../core/range_index.h"
+#include "../core/symbol_table.h"
 
 namespace MenuActions {
     void showMenu(double threshold, size_t windowSize, int menuLevel = 1);
-    void getStockData(std::vector<double>& stockPrices, const std::string& timeframe);
+    void getStockData(std::vector<double>& stockPrices, StockScanner::RangeIndex& priceIndex,
+                      StockScanner::SymbolTable& symbols, StockScanner::SymbolId& ticker, StockScanner::SymbolId timeframe);
     void calculateAverage(const std::vector<double>& stockPrices);
     void checkThreshold(const std::vector<double>& stockPrices, double threshold);
+    void runScreen(const std::vector<double>& stockPrices);
+    void rankStoredTickers(StockScanner::SymbolTable& symbols);
+    void windowStatistics(const StockScanner::RangeIndex& priceIndex);
     void modifyThreshold(double& threshold);
     void applySlidingWindow(const std::vector<double>& stockPrices, size_t windowSize);
     void modifyWindowSize(size_t& windowSize);
     void detectMomentum(const std::vector<double>& stockPrices, size_t windowSize);
-    void changeTimeframe(std::string& timeframe);
+    void rollingMedian(const std::vector<double>& stockPrices, size_t windowSize);
+    void backtestParameters(const std::vector<double>& stockPrices, StockScanner::SymbolId ticker);
+    void changeTimeframe(StockScanner::SymbolId& timeframe);
 }
\ No newline at end of file
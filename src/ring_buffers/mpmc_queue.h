@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+// Bounded lock-free queue for any number of producer and consumer threads, after Dmitry Vyukov's
+// bounded MPMC queue. Every cell of a power-of-two ring carries a sequence number saying whose
+// turn it is: a cell at ring position p is free for the producer of position p when its sequence
+// is p, and ready for the consumer of p when it is p + 1. Producers and consumers claim positions
+// with a compare-and-swap on their own cache-line-padded counter, then touch only the cells they
+// claimed, so a producer and a consumer never contend unless they meet at the same cell.
+//
+// Batch operations claim a run of positions with one compare-and-swap. A claimed cell may still
+// be in use by a thread that claimed the same cell one lap earlier and has not finished copying;
+// the batch waits for it, which takes at most the time of that one copy.
+template <typename T>
+class MPMCQueue {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return reinterpret_cast<T*>(storage); }
+    };
+
+    alignas(CACHE_LINE) std::atomic<size_t> enqueuePosition;
+    alignas(CACHE_LINE) std::atomic<size_t> dequeuePosition;
+    alignas(CACHE_LINE) std::unique_ptr<Cell[]> cells;
+    size_t capacity;    // Power of two
+    size_t mask;
+
+    static size_t roundCapacity(size_t requested) {
+        size_t rounded = 2;
+        while (rounded < requested) rounded *= 2;
+        return rounded;
+    }
+
+    // Signed distance between a cell's sequence and the one a thread expects
+    static intptr_t lag(size_t sequence, size_t expected) {
+        return static_cast<intptr_t>(sequence - expected);
+    }
+
+    // Spins until a claimed cell reaches the expected sequence
+    static void waitFor(const Cell& cell, size_t expected) {
+        while (cell.sequence.load(std::memory_order_acquire) != expected) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Claims up to count consecutive positions from counter, where the cell for position p is
+    // usable once its sequence reaches p + offset. A binary search over the run finds the longest
+    // one whose last cell is usable. Returns the first position and sets count to the number
+    // claimed, which is 0 when not even one position is usable.
+    size_t claim(std::atomic<size_t>& counter, size_t offset, size_t& count) {
+        size_t limit = std::min(count, capacity);
+        size_t position = counter.load(std::memory_order_relaxed);
+        while (true) {
+            size_t usable = 0, bound = limit;   // Runs of length usable work; longer than bound do not
+            bool stale = false;
+            while (usable < bound) {
+                size_t length = (usable + bound + 1) / 2;
+                size_t lastPosition = position + length - 1;
+                intptr_t difference = lag(cells[lastPosition & mask].sequence.load(std::memory_order_acquire), lastPosition + offset);
+                if (difference == 0) {
+                    usable = length;
+                } else if (difference < 0) {
+                    bound = length - 1;     // That cell is not ready yet
+                } else {
+                    stale = true;           // Another thread already took that position
+                    break;
+                }
+            }
+            if (stale) {
+                position = counter.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (usable == 0) {
+                count = 0;
+                return position;
+            }
+            if (counter.compare_exchange_weak(position, position + usable, std::memory_order_relaxed)) {
+                count = usable;
+                return position;
+            }
+            // Another thread moved the counter; position now holds its new value
+        }
+    }
+
+public:
+    // Constructor; the capacity is rounded up to a power of two
+    explicit MPMCQueue(size_t requestedCapacity = 1024)
+        : enqueuePosition(0), dequeuePosition(0), capacity(roundCapacity(requestedCapacity)), mask(capacity - 1) {
+        if (requestedCapacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+        cells.reset(new Cell[capacity]);
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    ~MPMCQueue() {
+        size_t end = enqueuePosition.load(std::memory_order_relaxed);
+        for (size_t position = dequeuePosition.load(std::memory_order_relaxed); position != end; ++position) {
+            cells[position & mask].value()->~T();
+        }
+    }
+
+    // Constructs an element from args at the tail; returns false if the queue is full
+    template <typename... Args>
+    bool tryEmplace(Args&&... args) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & mask];
+            intptr_t difference = lag(cell->sequence.load(std::memory_order_acquire), position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (difference < 0) {
+                return false;   // The cell still holds the element from one lap ago
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->storage) T(std::forward<Args>(args)...);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& value) { return tryEmplace(value); }
+    bool tryPush(T&& value) { return tryEmplace(std::move(value)); }
+
+    // Moves the head element into value; returns false if the queue is empty
+    bool tryPop(T& value) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & mask];
+            intptr_t difference = lag(cell->sequence.load(std::memory_order_acquire), position + 1);
+            if (difference == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (difference < 0) {
+                return false;   // Nothing has been published at this position yet
+            } else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        T* slot = cell->value();
+        value = std::move(*slot);
+        slot->~T();
+        cell->sequence.store(position + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pushes up to count elements read from first as one run of positions and returns how many
+    // were pushed. Elements of one batch stay contiguous and in order in the queue.
+    template <typename InputIterator>
+    size_t tryPushBatch(InputIterator first, size_t count) {
+        size_t position = claim(enqueuePosition, 0, count);
+        for (size_t i = 0; i < count; ++i, ++first) {
+            Cell& cell = cells[(position + i) & mask];
+            waitFor(cell, position + i);
+            new (cell.storage) T(*first);
+            cell.sequence.store(position + i + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Moves up to maxCount consecutive elements to out and returns how many were taken
+    template <typename OutputIterator>
+    size_t tryPopBatch(OutputIterator out, size_t maxCount) {
+        size_t position = claim(dequeuePosition, 1, maxCount);
+        for (size_t i = 0; i < maxCount; ++i, ++out) {
+            Cell& cell = cells[(position + i) & mask];
+            waitFor(cell, position + i + 1);
+            T* slot = cell.value();
+            *out = std::move(*slot);
+            slot->~T();
+            cell.sequence.store(position + i + mask + 1, std::memory_order_release);
+        }
+        return maxCount;
+    }
+
+    // Get the approximate number of queued elements; exact only when no thread is running
+    size_t getSize() const {
+        size_t head = dequeuePosition.load(std::memory_order_acquire);
+        size_t tail = enqueuePosition.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const {
+        return getSize() == 0;
+    }
+
+    // Get the capacity of the queue
+    size_t getCapacity() const {
+        return capacity;
+    }
+};
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Fixed-capacity circular buffer over one contiguous array, for bounded windows such as the last
+// N prices. Elements are indexed from the oldest (0) to the newest (size() - 1). Pushing and
+// popping at either end is O(1) and never allocates, and batch operations copy whole runs with at
+// most two block copies. segments() exposes the contents as at most two contiguous arrays, so
+// callers can run plain loops (or vectorized code) over a window without copying it out.
+template <typename T>
+class RingBuffer {
+public:
+    // A contiguous run of elements
+    struct Segment {
+        const T* data;
+        size_t size;
+    };
+
+    // Constructor; throws std::invalid_argument for a zero capacity
+    explicit RingBuffer(size_t capacity) : slots(capacity), head(0), count(0) {
+        if (capacity == 0) {
+            throw std::invalid_argument("RingBuffer capacity must be positive");
+        }
+    }
+
+    // Appends a value after the newest element; throws std::length_error if the buffer is full
+    void push_back(const T& value) {
+        if (full()) {
+            throw std::length_error("RingBuffer is full");
+        }
+        slots[physical(count)] = value;
+        ++count;
+    }
+
+    // Appends up to n values in order and returns how many fit
+    size_t push_back(const T* values, size_t n) {
+        size_t pushed = std::min(n, capacity() - count);
+        size_t start = physical(count);
+        size_t firstRun = std::min(pushed, capacity() - start);
+        std::copy(values, values + firstRun, slots.begin() + start);
+        std::copy(values + firstRun, values + pushed, slots.begin());
+        count += pushed;
+        return pushed;
+    }
+
+    // Removes and returns the oldest element; throws std::out_of_range if the buffer is empty
+    T pop_front() {
+        if (empty()) {
+            throw std::out_of_range("RingBuffer is empty");
+        }
+        T value = std::move(slots[head]);
+        head = physical(1);
+        --count;
+        return value;
+    }
+
+    // Moves up to n of the oldest elements to out in order and returns how many were taken
+    size_t pop_front(T* out, size_t n) {
+        size_t popped = std::min(n, count);
+        size_t firstRun = std::min(popped, capacity() - head);
+        std::move(slots.begin() + head, slots.begin() + head + firstRun, out);
+        std::move(slots.begin(), slots.begin() + (popped - firstRun), out + firstRun);
+        discardFront(popped);
+        return popped;
+    }
+
+    // Drops up to n of the oldest elements and returns how many were dropped
+    size_t pop_front(size_t n) {
+        size_t popped = std::min(n, count);
+        discardFront(popped);
+        return popped;
+    }
+
+    // Removes and returns the newest element; throws std::out_of_range if the buffer is empty
+    T pop_back() {
+        if (empty()) {
+            throw std::out_of_range("RingBuffer is empty");
+        }
+        --count;
+        return std::move(slots[physical(count)]);
+    }
+
+    // Moves up to n of the newest elements to out, newest first, and returns how many were taken
+    size_t pop_back(T* out, size_t n) {
+        size_t popped = std::min(n, count);
+        for (size_t i = 0; i < popped; ++i) {
+            out[i] = std::move(slots[physical(count - 1 - i)]);
+        }
+        count -= popped;
+        return popped;
+    }
+
+    // Element access, oldest first; operator[] is unchecked and at() throws std::out_of_range
+    T& operator[](size_t index) { return slots[physical(index)]; }
+    const T& operator[](size_t index) const { return slots[physical(index)]; }
+
+    const T& at(size_t index) const {
+        if (index >= count) {
+            throw std::out_of_range("RingBuffer index out of range");
+        }
+        return slots[physical(index)];
+    }
+
+    const T& front() const { return at(0); }
+    const T& back() const { return at(count - 1); }
+
+    // The contents, oldest first, as two contiguous runs; the second is empty unless the contents
+    // wrap around the end of the array
+    std::pair<Segment, Segment> segments() const {
+        size_t firstRun = std::min(count, capacity() - head);
+        return {Segment{slots.data() + head, firstRun}, Segment{slots.data(), count - firstRun}};
+    }
+
+    // Grows the capacity to at least newCapacity, moving the contents to the start of the new array
+    void reserve(size_t newCapacity) {
+        if (newCapacity <= capacity()) return;
+        std::vector<T> grown(newCapacity);
+        for (size_t i = 0; i < count; ++i) {
+            grown[i] = std::move(slots[physical(i)]);
+        }
+        slots = std::move(grown);
+        head = 0;
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return slots.size(); }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == slots.size(); }
+
+private:
+    std::vector<T> slots;
+    size_t head;    // Array index of the oldest element
+    size_t count;   // Number of elements held
+
+    // Array index of the element `index` places after the oldest; valid for index <= capacity()
+    size_t physical(size_t index) const {
+        size_t position = head + index;
+        return position >= slots.size() ? position - slots.size() : position;
+    }
+
+    void discardFront(size_t n) {
+        head = physical(n);
+        count -= n;
+        if (count == 0) head = 0;   // Restart at the array start so the next batch is one run
+    }
+};
+
+// Stack over a RingBuffer with the interface of the linked Stack; the buffer doubles when full.
+// Elements sit next to each other in one array, so there is no allocation per element.
+template <typename T = int>
+class RingBufferStack {
+private:
+    RingBuffer<T> buffer;
+
+public:
+    explicit RingBufferStack(size_t initialCapacity = 16) : buffer(initialCapacity) {}
+
+    void Insert(const T& value) {
+        if (buffer.full()) buffer.reserve(buffer.capacity() * 2);
+        buffer.push_back(value);
+    }
+
+    T Remove() {
+        if (buffer.empty()) {
+            throw std::out_of_range("Stack is empty. Cannot remove.");
+        }
+        return buffer.pop_back();
+    }
+
+    // Pushes count values in order, growing as needed
+    void InsertBatch(const T* values, size_t count) {
+        if (buffer.size() + count > buffer.capacity()) {
+            buffer.reserve(std::max(buffer.capacity() * 2, buffer.size() + count));
+        }
+        buffer.push_back(values, count);
+    }
+
+    // Pops up to count values into out, top first, and returns how many were popped
+    size_t RemoveBatch(T* out, size_t count) {
+        return buffer.pop_back(out, count);
+    }
+
+    // Prints the stack from top to bottom
+    void Print() const {
+        std::cout << "Stack (top to bottom): ";
+        for (size_t i = buffer.size(); i > 0; --i) {
+            std::cout << buffer[i - 1] << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    int getSize() const noexcept { return static_cast<int>(buffer.size()); }
+};
+
+// Queue over a RingBuffer with the interface of the linked Queue; the buffer doubles when full
+template <typename T = int>
+class RingBufferQueue {
+private:
+    RingBuffer<T> buffer;
+
+public:
+    explicit RingBufferQueue(size_t initialCapacity = 16) : buffer(initialCapacity) {}
+
+    void Insert(const T& value) {
+        if (buffer.full()) buffer.reserve(buffer.capacity() * 2);
+        buffer.push_back(value);
+    }
+
+    T Remove() {
+        if (buffer.empty()) {
+            throw std::out_of_range("Queue is empty. Cannot remove.");
+        }
+        return buffer.pop_front();
+    }
+
+    // Enqueues count values in order, growing as needed
+    void InsertBatch(const T* values, size_t count) {
+        if (buffer.size() + count > buffer.capacity()) {
+            buffer.reserve(std::max(buffer.capacity() * 2, buffer.size() + count));
+        }
+        buffer.push_back(values, count);
+    }
+
+    // Dequeues up to count values into out, front first, and returns how many were dequeued
+    size_t RemoveBatch(T* out, size_t count) {
+        return buffer.pop_front(out, count);
+    }
+
+    // Prints the queue from front to rear
+    void Print() const {
+        std::cout << "Queue (front to rear): ";
+        for (size_t i = 0; i < buffer.size(); ++i) {
+            std::cout << buffer[i] << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    int getSize() const { return static_cast<int>(buffer.size()); }
+};
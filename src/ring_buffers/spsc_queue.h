@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread, such as a
+// fetch thread handing bars to a parser. Elements live in a power-of-two ring. The producer owns
+// the tail index and the consumer the head index, each on its own cache line, and each side keeps
+// a private copy of the other's index so it only reads the shared one (and takes the cache miss)
+// when its copy says the ring looks full or empty. Batch operations publish many elements with a
+// single release store.
+template <typename T>
+class SPSCQueue {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    // Consumer side
+    alignas(CACHE_LINE) std::atomic<size_t> head;   // Next position to pop
+    size_t cachedTail;                              // Consumer's last view of tail
+
+    // Producer side
+    alignas(CACHE_LINE) std::atomic<size_t> tail;   // Next position to push
+    size_t cachedHead;                              // Producer's last view of head
+
+    // Shared, read-only after construction
+    alignas(CACHE_LINE) T* slots;
+    size_t capacity;    // Power of two
+    size_t mask;
+    std::allocator<T> allocator;
+
+    static size_t roundCapacity(size_t requested) {
+        size_t rounded = 2;
+        while (rounded < requested) rounded *= 2;
+        return rounded;
+    }
+
+    // Free slots as seen by the producer, refreshing its view of head only when needed
+    size_t freeSlots(size_t position, size_t wanted) {
+        size_t available = capacity - (position - cachedHead);
+        if (available < wanted) {
+            cachedHead = head.load(std::memory_order_acquire);
+            available = capacity - (position - cachedHead);
+        }
+        return available;
+    }
+
+    // Filled slots as seen by the consumer, refreshing its view of tail only when needed
+    size_t filledSlots(size_t position, size_t wanted) {
+        size_t available = cachedTail - position;
+        if (available < wanted) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            available = cachedTail - position;
+        }
+        return available;
+    }
+
+public:
+    // Constructor; the capacity is rounded up to a power of two
+    explicit SPSCQueue(size_t requestedCapacity = 1024)
+        : head(0), cachedTail(0), tail(0), cachedHead(0), slots(nullptr),
+          capacity(roundCapacity(requestedCapacity)), mask(capacity - 1) {
+        if (requestedCapacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+        slots = allocator.allocate(capacity);
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    ~SPSCQueue() {
+        size_t end = tail.load(std::memory_order_relaxed);
+        for (size_t position = head.load(std::memory_order_relaxed); position != end; ++position) {
+            slots[position & mask].~T();
+        }
+        allocator.deallocate(slots, capacity);
+    }
+
+    // Producer: constructs an element from args at the tail; returns false if the queue is full
+    template <typename... Args>
+    bool tryEmplace(Args&&... args) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (freeSlots(position, 1) == 0) return false;
+        new (slots + (position & mask)) T(std::forward<Args>(args)...);
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& value) { return tryEmplace(value); }
+    bool tryPush(T&& value) { return tryEmplace(std::move(value)); }
+
+    // Producer: pushes up to count elements read from first and returns how many fit
+    template <typename InputIterator>
+    size_t tryPushBatch(InputIterator first, size_t count) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        size_t pushed = std::min(count, freeSlots(position, count));
+        for (size_t i = 0; i < pushed; ++i, ++first) {
+            new (slots + ((position + i) & mask)) T(*first);
+        }
+        if (pushed > 0) tail.store(position + pushed, std::memory_order_release);
+        return pushed;
+    }
+
+    // Consumer: moves the head element into value; returns false if the queue is empty
+    bool tryPop(T& value) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (filledSlots(position, 1) == 0) return false;
+        T& slot = slots[position & mask];
+        value = std::move(slot);
+        slot.~T();
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: moves up to maxCount elements to out and returns how many were taken
+    template <typename OutputIterator>
+    size_t tryPopBatch(OutputIterator out, size_t maxCount) {
+        size_t position = head.load(std::memory_order_relaxed);
+        size_t popped = std::min(maxCount, filledSlots(position, maxCount));
+        for (size_t i = 0; i < popped; ++i, ++out) {
+            T& slot = slots[(position + i) & mask];
+            *out = std::move(slot);
+            slot.~T();
+        }
+        if (popped > 0) head.store(position + popped, std::memory_order_release);
+        return popped;
+    }
+
+    // Get the number of queued elements; exact only when neither side is running
+    size_t getSize() const {
+        size_t position = head.load(std::memory_order_acquire);    // Read first so tail cannot be behind it
+        return tail.load(std::memory_order_acquire) - position;
+    }
+
+    bool empty() const {
+        return getSize() == 0;
+    }
+
+    // Get the capacity of the queue
+    size_t getCapacity() const {
+        return capacity;
+    }
+};
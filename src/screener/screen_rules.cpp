@@ -0,0 +1,407 @@
+#include "screen_rules.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace StockScanner {
+
+    // Recursive descent parser that emits the postfix program of a ScreenRule directly.
+    // Grammar (lowest to highest precedence):
+    //   or         := and ( ("or" | "||") and )*
+    //   and        := not ( ("and" | "&&") not )*
+    //   not        := ("not" | "!") not | comparison
+    //   comparison := additive ( ("<" | "<=" | ">" | ">=" | "==" | "!=") additive )?
+    //   additive   := term ( ("+" | "-") term )*
+    //   term       := unary ( ("*" | "/") unary )*
+    //   unary      := "-" unary | primary
+    //   primary    := number | indicator | "(" or ")"
+    //   indicator  := name "(" [integer] ")" | name
+    class ScreenRuleParser {
+    public:
+        ScreenRuleParser(ScreenRule& rule, const std::string& text) : rule(rule), text(text), pos(0), depth(0) {}
+
+        void parse() {
+            parseOr();
+            skipWhitespace();
+            if (pos != text.size()) {
+                fail("unexpected '" + std::string(1, text[pos]) + "'");
+            }
+        }
+
+    private:
+        using OpCode = ScreenRule::OpCode;
+
+        ScreenRule& rule;
+        const std::string& text;
+        size_t pos;
+        size_t depth;   // Values on the evaluation stack after the instructions emitted so far
+
+        [[noreturn]] void fail(const std::string& message) const {
+            throw std::invalid_argument("Screen rule error at position " + std::to_string(pos) + ": " + message);
+        }
+
+        // Appends an instruction and tracks the deepest the evaluation stack can get
+        void emit(OpCode op, double constant = 0.0, size_t slot = 0) {
+            rule.program.push_back({op, constant, slot});
+            if (op == OpCode::PushIndicator || op == OpCode::PushConstant) {
+                rule.maxStackDepth = std::max(rule.maxStackDepth, ++depth);
+            } else if (op != OpCode::Negate && op != OpCode::Not) {
+                --depth;    // Binary operators pop two values and push one
+            }
+        }
+
+        void skipWhitespace() {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+                ++pos;
+            }
+        }
+
+        // Consumes the symbol if it is next in the input
+        bool matchSymbol(const char* symbol) {
+            skipWhitespace();
+            size_t length = std::char_traits<char>::length(symbol);
+            if (text.compare(pos, length, symbol) == 0) {
+                pos += length;
+                return true;
+            }
+            return false;
+        }
+
+        // Consumes the keyword if it is next in the input as a whole word
+        bool matchKeyword(const char* keyword) {
+            skipWhitespace();
+            size_t length = std::char_traits<char>::length(keyword);
+            if (text.compare(pos, length, keyword) != 0) return false;
+            size_t end = pos + length;
+            if (end < text.size() && (std::isalnum(static_cast<unsigned char>(text[end])) || text[end] == '_')) {
+                return false;
+            }
+            pos = end;
+            return true;
+        }
+
+        void parseOr() {
+            parseAnd();
+            while (matchKeyword("or") || matchSymbol("||")) {
+                parseAnd();
+                emit(OpCode::Or);
+            }
+        }
+
+        void parseAnd() {
+            parseNot();
+            while (matchKeyword("and") || matchSymbol("&&")) {
+                parseNot();
+                emit(OpCode::And);
+            }
+        }
+
+        void parseNot() {
+            skipWhitespace();
+            if (matchKeyword("not") || (text.compare(pos, 2, "!=") != 0 && matchSymbol("!"))) {
+                parseNot();
+                emit(OpCode::Not);
+                return;
+            }
+            parseComparison();
+        }
+
+        void parseComparison() {
+            parseAdditive();
+
+            // Two-character operators must be tried before their one-character prefixes
+            OpCode op;
+            if (matchSymbol("<=")) op = OpCode::LessEqual;
+            else if (matchSymbol(">=")) op = OpCode::GreaterEqual;
+            else if (matchSymbol("==")) op = OpCode::Equal;
+            else if (matchSymbol("!=")) op = OpCode::NotEqual;
+            else if (matchSymbol("<")) op = OpCode::Less;
+            else if (matchSymbol(">")) op = OpCode::Greater;
+            else return;
+
+            parseAdditive();
+            emit(op);
+        }
+
+        void parseAdditive() {
+            parseTerm();
+            while (true) {
+                if (matchSymbol("+")) {
+                    parseTerm();
+                    emit(OpCode::Add);
+                } else if (matchSymbol("-")) {
+                    parseTerm();
+                    emit(OpCode::Subtract);
+                } else {
+                    return;
+                }
+            }
+        }
+
+        void parseTerm() {
+            parseUnary();
+            while (true) {
+                if (matchSymbol("*")) {
+                    parseUnary();
+                    emit(OpCode::Multiply);
+                } else if (matchSymbol("/")) {
+                    parseUnary();
+                    emit(OpCode::Divide);
+                } else {
+                    return;
+                }
+            }
+        }
+
+        void parseUnary() {
+            if (matchSymbol("-")) {
+                parseUnary();
+                emit(OpCode::Negate);
+                return;
+            }
+            parsePrimary();
+        }
+
+        void parsePrimary() {
+            skipWhitespace();
+            if (pos >= text.size()) {
+                fail("unexpected end of rule");
+            }
+
+            char c = text[pos];
+            if (matchSymbol("(")) {
+                parseOr();
+                if (!matchSymbol(")")) fail("expected ')'");
+            } else if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+                emit(OpCode::PushConstant, parseNumber());
+            } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+                parseIndicator();
+            } else {
+                fail("unexpected '" + std::string(1, c) + "'");
+            }
+        }
+
+        double parseNumber() {
+            size_t consumed = 0;
+            double value = 0.0;
+            try {
+                value = std::stod(text.substr(pos), &consumed);
+            } catch (const std::exception&) {
+                fail("invalid number");
+            }
+            pos += consumed;
+            return value;
+        }
+
+        // Reads a decimal period of digits only, between 1 and MAX_PERIOD
+        size_t parsePeriod(const std::string& name) {
+            size_t value = 0;
+            for (; pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos])); ++pos) {
+                value = value * 10 + static_cast<size_t>(text[pos] - '0');
+                if (value > ScreenRule::MAX_PERIOD) {
+                    fail("period for '" + name + "' must be at most " + std::to_string(ScreenRule::MAX_PERIOD));
+                }
+            }
+            if (value == 0 || (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '.'))) {
+                fail("period for '" + name + "' must be a positive integer");
+            }
+            return value;
+        }
+
+        void parseIndicator() {
+            size_t start = pos;
+            while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '_')) {
+                ++pos;
+            }
+            std::string name = text.substr(start, pos - start);
+
+            IndicatorType type;
+            bool needsPeriod = true;
+            if (name == "close" || name == "price") {
+                type = IndicatorType::Close;
+                needsPeriod = false;
+            } else if (name == "pct_change") type = IndicatorType::PctChange;
+            else if (name == "sma") type = IndicatorType::Sma;
+            else if (name == "min") type = IndicatorType::Min;
+            else if (name == "max") type = IndicatorType::Max;
+            else if (name == "up_run") type = IndicatorType::UpRun;
+            else if (name == "down_run") type = IndicatorType::DownRun;
+            else {
+                pos = start;
+                fail("unknown indicator '" + name + "'");
+            }
+
+            size_t period = 1;
+            if (matchSymbol("(")) {
+                skipWhitespace();
+                if (needsPeriod) {
+                    if (pos >= text.size() || !std::isdigit(static_cast<unsigned char>(text[pos]))) {
+                        fail("expected a period for '" + name + "'");
+                    }
+                    period = parsePeriod(name);
+                }
+                if (!matchSymbol(")")) fail("expected ')'");
+            } else if (needsPeriod) {
+                fail("expected '(' after '" + name + "'");
+            }
+
+            emit(OpCode::PushIndicator, 0.0, rule.addIndicator({type, period}));
+        }
+    };
+
+    ScreenRule::ScreenRule(const std::string& expression) : expression(expression), maxLookback(0), maxStackDepth(0) {
+        ScreenRuleParser(*this, expression).parse();
+
+        std::sort(schedule.begin(), schedule.end(),
+                  [](const ScheduleEntry& a, const ScheduleEntry& b) { return a.step < b.step; });
+    }
+
+    // Registers an indicator once and returns its value slot
+    size_t ScreenRule::addIndicator(const IndicatorSpec& spec) {
+        auto it = std::find(indicators.begin(), indicators.end(), spec);
+        if (it != indicators.end()) {
+            return static_cast<size_t>(it - indicators.begin());
+        }
+
+        // Number of trailing prices needed before the indicator's value is known
+        size_t step = spec.period;
+        if (spec.type == IndicatorType::Close) {
+            step = 1;
+        } else if (spec.type == IndicatorType::PctChange || spec.type == IndicatorType::UpRun ||
+                   spec.type == IndicatorType::DownRun) {
+            step = spec.period + 1;
+        }
+
+        size_t slot = indicators.size();
+        indicators.push_back(spec);
+        schedule.push_back({step, slot});
+        maxLookback = std::max(maxLookback, step);
+        return slot;
+    }
+
+    // Computes every indicator in one pass walking back from the latest price.
+    // Running sum, min, max and run state are shared by all indicators; each one
+    // is read off when the pass reaches its lookback.
+    void ScreenRule::computeIndicators(const std::vector<double>& prices, double* values) const {
+        const size_t n = prices.size();
+        const double latest = prices[n - 1];
+
+        double sum = 0.0;
+        double low = latest;
+        double high = latest;
+        bool upRun = true;
+        bool downRun = true;
+
+        size_t next = 0;
+        for (size_t step = 1; step <= maxLookback; ++step) {
+            const size_t index = n - step;
+            const double price = prices[index];
+
+            sum += price;
+            low = std::min(low, price);
+            high = std::max(high, price);
+            if (step > 1) {
+                upRun = upRun && price < prices[index + 1];
+                downRun = downRun && price > prices[index + 1];
+            }
+
+            for (; next < schedule.size() && schedule[next].step == step; ++next) {
+                const IndicatorSpec& spec = indicators[schedule[next].slot];
+                double& value = values[schedule[next].slot];
+                switch (spec.type) {
+                    case IndicatorType::Close: value = latest; break;
+                    case IndicatorType::PctChange: value = (latest - price) / price * 100.0; break;
+                    case IndicatorType::Sma: value = sum / static_cast<double>(spec.period); break;
+                    case IndicatorType::Min: value = low; break;
+                    case IndicatorType::Max: value = high; break;
+                    case IndicatorType::UpRun: value = upRun ? 1.0 : 0.0; break;
+                    case IndicatorType::DownRun: value = downRun ? 1.0 : 0.0; break;
+                }
+            }
+        }
+    }
+
+    ScreenRule::Workspace ScreenRule::makeWorkspace() const {
+        Workspace workspace;
+        workspace.values.resize(indicators.size());
+        workspace.stack.resize(maxStackDepth);
+        return workspace;
+    }
+
+    bool ScreenRule::evaluate(const std::vector<double>& prices) const {
+        Workspace workspace = makeWorkspace();
+        return evaluate(prices, workspace);
+    }
+
+    bool ScreenRule::evaluate(const std::vector<double>& prices, Workspace& workspace) const {
+        if (prices.empty() || prices.size() < maxLookback) return false;
+        if (workspace.values.size() < indicators.size() || workspace.stack.size() < maxStackDepth) {
+            workspace = makeWorkspace();    // Workspace made for another rule
+        }
+
+        double* values = workspace.values.data();
+        computeIndicators(prices, values);
+
+        double* stack = workspace.stack.data();
+        size_t top = 0;     // Number of values on the stack
+        for (const auto& instruction : program) {
+            if (instruction.op == OpCode::PushIndicator) {
+                stack[top++] = values[instruction.slot];
+                continue;
+            }
+            if (instruction.op == OpCode::PushConstant) {
+                stack[top++] = instruction.constant;
+                continue;
+            }
+            if (instruction.op == OpCode::Negate) {
+                stack[top - 1] = -stack[top - 1];
+                continue;
+            }
+            if (instruction.op == OpCode::Not) {
+                stack[top - 1] = stack[top - 1] == 0.0 ? 1.0 : 0.0;
+                continue;
+            }
+
+            double rhs = stack[--top];
+            double& lhs = stack[top - 1];
+            switch (instruction.op) {
+                case OpCode::Add: lhs = lhs + rhs; break;
+                case OpCode::Subtract: lhs = lhs - rhs; break;
+                case OpCode::Multiply: lhs = lhs * rhs; break;
+                case OpCode::Divide: lhs = lhs / rhs; break;
+                case OpCode::Less: lhs = lhs < rhs; break;
+                case OpCode::LessEqual: lhs = lhs <= rhs; break;
+                case OpCode::Greater: lhs = lhs > rhs; break;
+                case OpCode::GreaterEqual: lhs = lhs >= rhs; break;
+                case OpCode::Equal: lhs = lhs == rhs; break;
+                case OpCode::NotEqual: lhs = lhs != rhs; break;
+                case OpCode::And: lhs = (lhs != 0.0 && rhs != 0.0); break;
+                case OpCode::Or: lhs = (lhs != 0.0 || rhs != 0.0); break;
+                default: break;
+            }
+        }
+
+        return stack[top - 1] != 0.0;
+    }
+
+    std::vector<SymbolId> screenUniverse(const ScreenRule& rule, const std::vector<std::vector<double>>& universe) {
+        std::vector<SymbolId> matches;
+        ScreenRule::Workspace workspace = rule.makeWorkspace();    // Shared by every series, so no per-ticker allocation
+        for (SymbolId id = 0; id < universe.size(); ++id) {
+            if (rule.evaluate(universe[id], workspace)) {
+                matches.push_back(id);
+            }
+        }
+        return matches;
+    }
+
+    std::vector<ScanRecord> rankUniverse(const ScreenRule& rule, const std::vector<std::vector<double>>& universe, size_t k) {
+        std::vector<ScanRecord> records;
+        for (SymbolId id : screenUniverse(rule, universe)) {
+            const std::vector<double>& prices = universe[id];
+            if (prices.size() < 2 || prices.front() == 0.0) continue;
+            records.push_back({id, (prices.back() - prices.front()) / prices.front() * 100.0});
+        }
+        return topK(records, k);
+    }
+}
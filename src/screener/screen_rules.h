@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include "../core/symbol_table.h"
+#include "../sorting/top_k.h"
+
+namespace StockScanner {
+
+    // Indicators that a screening rule can reference
+    enum class IndicatorType {
+        Close,      // close(): latest price
+        PctChange,  // pct_change(n): percent change over the last n bars
+        Sma,        // sma(n): simple moving average of the last n prices
+        Min,        // min(n): lowest of the last n prices
+        Max,        // max(n): highest of the last n prices
+        UpRun,      // up_run(n): 1 if each of the last n moves was up, else 0
+        DownRun     // down_run(n): 1 if each of the last n moves was down, else 0
+    };
+
+    struct IndicatorSpec {
+        IndicatorType type;
+        size_t period;
+
+        bool operator==(const IndicatorSpec& other) const {
+            return type == other.type && period == other.period;
+        }
+    };
+
+    // A screening rule such as "pct_change(20) > 5 and sma(5) > sma(20) and up_run(3)".
+    // The text is parsed once into a postfix program. Every indicator the rule
+    // references is computed in a single backward pass over the tail of a series,
+    // so identical indicators and the running sum are shared between criteria.
+    class ScreenRule {
+    public:
+        // Longest indicator period a rule may use
+        static constexpr size_t MAX_PERIOD = 1000000;
+
+        // Scratch space for evaluate: one slot per indicator and the evaluation stack
+        struct Workspace {
+            std::vector<double> values;
+            std::vector<double> stack;
+        };
+
+        // Parses and compiles the expression; throws std::invalid_argument on syntax errors
+        explicit ScreenRule(const std::string& expression);
+
+        // Returns true if the latest bar of the series satisfies the rule.
+        // Series shorter than lookback() never match. This overload allocates a workspace per
+        // call; loops over many series should reuse one from makeWorkspace().
+        bool evaluate(const std::vector<double>& prices) const;
+
+        // Same as above without allocating, given a workspace from makeWorkspace(). Each thread
+        // needs its own workspace.
+        bool evaluate(const std::vector<double>& prices, Workspace& workspace) const;
+
+        // A workspace sized for this rule
+        Workspace makeWorkspace() const;
+
+        // Number of trailing prices the rule needs to be evaluated
+        size_t lookback() const { return maxLookback; }
+
+        const std::vector<IndicatorSpec>& getIndicators() const { return indicators; }
+        const std::string& getExpression() const { return expression; }
+
+    private:
+        enum class OpCode {
+            PushIndicator, PushConstant,
+            Add, Subtract, Multiply, Divide, Negate,
+            Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual,
+            And, Or, Not
+        };
+
+        struct Instruction {
+            OpCode op;
+            double constant;  // PushConstant operand
+            size_t slot;      // PushIndicator operand (index into indicators)
+        };
+
+        // A point in the backward pass at which an indicator's value is complete
+        struct ScheduleEntry {
+            size_t step;      // Number of prices consumed, counting back from the latest
+            size_t slot;
+        };
+
+        std::string expression;
+        std::vector<IndicatorSpec> indicators;  // Deduplicated indicators referenced by the rule
+        std::vector<Instruction> program;       // Postfix program over indicator values
+        std::vector<ScheduleEntry> schedule;    // Sorted by step
+        size_t maxLookback;
+        size_t maxStackDepth;                   // Deepest the evaluation stack gets while running program
+
+        size_t addIndicator(const IndicatorSpec& spec);
+        void computeIndicators(const std::vector<double>& prices, double* values) const;
+
+        friend class ScreenRuleParser;
+    };
+
+    // Evaluates a compiled rule against every series in the universe, where universe[id] is
+    // the series of symbol id, and returns the IDs of the matching symbols in increasing order
+    std::vector<SymbolId> screenUniverse(const ScreenRule& rule, const std::vector<std::vector<double>>& universe);
+
+    // Screens the universe like screenUniverse and ranks the matches by percent change from their
+    // first to their last price, returning the k largest movers, highest first. Matches with fewer
+    // than two prices or a zero first price have no percent change and are left out.
+    std::vector<ScanRecord> rankUniverse(const ScreenRule& rule, const std::vector<std::vector<double>>& universe, size_t k);
+}
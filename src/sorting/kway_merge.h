@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+// Lazily merges k already-sorted sources into one sorted stream using a tournament (loser) tree.
+// Each internal node remembers the loser of the match played there and the overall winner sits
+// at the top, so producing the next value replays only the path from the winner's leaf to the
+// root: about log2(k) comparisons per value. Per source it keeps a cursor and one tree slot, and
+// the sources are read in place, never copied, so they must outlive the merger. Equal values come out in source order.
+template <typename T, typename Compare = std::less<T>>
+class KWayMerger {
+public:
+    explicit KWayMerger(const std::vector<std::vector<T>>& sources, Compare compare = Compare())
+        : compare(compare), sourceCount(sources.size()), tree(std::max<size_t>(1, sources.size())) {
+        cursors.reserve(sourceCount);
+        for (const auto& source : sources) {
+            cursors.emplace_back(source.data(), source.data() + source.size());
+        }
+        build();
+    }
+
+    // True once every source is exhausted
+    bool empty() const { return sourceCount == 0 || exhausted(tree[0]); }
+
+    // The smallest remaining value and the index of the source it came from
+    const T& top() const {
+        if (empty()) throw std::out_of_range("KWayMerger is empty");
+        return *cursors[tree[0]].first;
+    }
+
+    size_t topSource() const {
+        if (empty()) throw std::out_of_range("KWayMerger is empty");
+        return tree[0];
+    }
+
+    // Consumes top() and replays its source's path to find the next winner
+    void pop() {
+        if (empty()) throw std::out_of_range("KWayMerger is empty");
+        size_t winner = tree[0];
+        ++cursors[winner].first;
+
+        for (size_t node = (winner + sourceCount) / 2; node > 0; node /= 2) {
+            if (beats(tree[node], winner)) std::swap(tree[node], winner);
+        }
+        tree[0] = winner;
+    }
+
+    // Copies the next value and its source out and advances; returns false once empty
+    bool next(T& value, size_t& source) {
+        if (empty()) return false;
+        value = top();
+        source = tree[0];
+        pop();
+        return true;
+    }
+
+private:
+    Compare compare;
+    size_t sourceCount;
+    std::vector<std::pair<const T*, const T*>> cursors; // (next, end) per source
+    std::vector<size_t> tree; // tree[0] is the winner, tree[1..k-1] the loser at each internal node
+
+    bool exhausted(size_t source) const { return cursors[source].first == cursors[source].second; }
+
+    // Whether source a's next value goes before source b's; exhausted sources lose to everything
+    bool beats(size_t a, size_t b) const {
+        if (exhausted(a)) return false;
+        if (exhausted(b)) return true;
+        if (compare(*cursors[a].first, *cursors[b].first)) return true;
+        if (compare(*cursors[b].first, *cursors[a].first)) return false;
+        return a < b;
+    }
+
+    // Plays the initial tournament. Leaves are nodes k..2k-1 of an implicit binary tree,
+    // so node n's children are 2n and 2n+1 for any k, not just powers of two.
+    void build() {
+        if (sourceCount == 0) return;
+
+        std::vector<size_t> winners(2 * sourceCount);
+        for (size_t i = 0; i < sourceCount; ++i) {
+            winners[sourceCount + i] = i;
+        }
+        for (size_t node = sourceCount - 1; node > 0; --node) {
+            size_t left = winners[2 * node];
+            size_t right = winners[2 * node + 1];
+            bool leftWins = beats(left, right);
+            winners[node] = leftWins ? left : right;
+            tree[node] = leftWins ? right : left;
+        }
+        tree[0] = sourceCount == 1 ? 0 : winners[1];
+    }
+};
+
+// Merges every source into one sorted vector
+template <typename T, typename Compare = std::less<T>>
+std::vector<T> kWayMerge(const std::vector<std::vector<T>>& sources, Compare compare = Compare()) {
+    size_t total = 0;
+    for (const auto& source : sources) total += source.size();
+
+    std::vector<T> merged;
+    merged.reserve(total);
+    for (KWayMerger<T, Compare> merger(sources, compare); !merger.empty(); merger.pop()) {
+        merged.push_back(merger.top());
+    }
+    return merged;
+}
@@ -0,0 +1,237 @@
+#include "simd_sort.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_SORT_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if SIMD_SORT_X86
+
+static unsigned countBits(unsigned mask) {
+    unsigned count = 0;
+    for (; mask != 0; mask &= mask - 1) ++count;
+    return count;
+}
+
+// For each 4-bit mask of AVX2 lanes going low, the 32-bit lane permutation that moves those
+// doubles to the front and the rest to the back, each group keeping its order
+static constexpr std::array<std::array<int32_t, 8>, 16> makeAvx2PartitionTable() {
+    std::array<std::array<int32_t, 8>, 16> table{};
+    for (unsigned mask = 0; mask < 16; ++mask) {
+        size_t out = 0;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int lane = 0; lane < 4; ++lane) {
+                bool low = (mask >> lane) & 1;
+                if (low == (pass == 0)) {
+                    table[mask][out++] = 2 * lane;
+                    table[mask][out++] = 2 * lane + 1;
+                }
+            }
+        }
+    }
+    return table;
+}
+
+alignas(32) static constexpr std::array<std::array<int32_t, 8>, 16> AVX2_PARTITION_TABLE = makeAvx2PartitionTable();
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace SimdAvx2 {
+    struct Ops {
+        using Reg = __m256d;
+        static constexpr size_t LANES = 4;
+
+        static Reg load(const double* source) { return _mm256_loadu_pd(source); }
+        static void store(double* target, Reg v) { _mm256_storeu_pd(target, v); }
+        static Reg set1(double value) { return _mm256_set1_pd(value); }
+        static Reg min(Reg a, Reg b) { return _mm256_min_pd(a, b); }
+        static Reg max(Reg a, Reg b) { return _mm256_max_pd(a, b); }
+        static Reg reverse(Reg v) { return _mm256_permute4x64_pd(v, 0x1B); }
+
+        // Compare-exchange of each lane with its partner in swapped; lanes in the blend mask keep the max
+        template <int HighLanes>
+        static Reg exchange(Reg v, Reg swapped) {
+            return _mm256_blend_pd(_mm256_min_pd(v, swapped), _mm256_max_pd(v, swapped), HighLanes);
+        }
+
+        static Reg swapPairs(Reg v) { return _mm256_permute_pd(v, 0x5); }          // [1, 0, 3, 2]
+        static Reg swapHalves(Reg v) { return _mm256_permute4x64_pd(v, 0x4E); }    // [2, 3, 0, 1]
+
+        static Reg sortRegister(Reg v) {
+            v = exchange<0xA>(v, swapPairs(v));
+            v = exchange<0xC>(v, reverse(v));
+            return exchange<0xA>(v, swapPairs(v));
+        }
+
+        static Reg cleanRegister(Reg v) {
+            v = exchange<0xC>(v, swapHalves(v));
+            return exchange<0xA>(v, swapPairs(v));
+        }
+
+        // Writes v's low lanes from lowEnd and its high lanes so they end at highBegin, returning
+        // the number of low lanes. Both stores write a whole register; the partition keeps a
+        // register of free space at each end so the extra lanes land on free slots.
+        static size_t partitionStore(double* lowEnd, double* highBegin, Reg v, Reg pivot, bool orEqual) {
+            Reg lowLanes = orEqual ? _mm256_cmp_pd(v, pivot, _CMP_LE_OQ) : _mm256_cmp_pd(v, pivot, _CMP_LT_OQ);
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(lowLanes));
+            __m256i permutation = _mm256_load_si256(reinterpret_cast<const __m256i*>(AVX2_PARTITION_TABLE[mask].data()));
+            Reg packed = _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(v), permutation));
+            _mm256_storeu_pd(lowEnd, packed);
+            _mm256_storeu_pd(highBegin - LANES, packed);
+            return countBits(mask);
+        }
+    };
+
+#include "simd_sort_kernels.inc"
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+namespace SimdAvx512 {
+    struct Ops {
+        using Reg = __m512d;
+        static constexpr size_t LANES = 8;
+
+        static Reg load(const double* source) { return _mm512_loadu_pd(source); }
+        static void store(double* target, Reg v) { _mm512_storeu_pd(target, v); }
+        static Reg set1(double value) { return _mm512_set1_pd(value); }
+        static Reg min(Reg a, Reg b) { return _mm512_min_pd(a, b); }
+        static Reg max(Reg a, Reg b) { return _mm512_max_pd(a, b); }
+        static Reg reverse(Reg v) { return _mm512_permutexvar_pd(_mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7), v); }
+
+        static Reg exchange(Reg v, Reg swapped, __mmask8 highLanes) {
+            return _mm512_mask_blend_pd(highLanes, _mm512_min_pd(v, swapped), _mm512_max_pd(v, swapped));
+        }
+
+        static Reg swapPairs(Reg v) { return _mm512_permute_pd(v, 0x55); }                               // [1, 0, 3, 2, ...]
+        static Reg swapQuads(Reg v) { return _mm512_permutex_pd(v, _MM_SHUFFLE(1, 0, 3, 2)); }          // [2, 3, 0, 1, ...]
+        static Reg reverseQuads(Reg v) { return _mm512_permutex_pd(v, _MM_SHUFFLE(0, 1, 2, 3)); }       // [3, 2, 1, 0, ...]
+        static Reg swapHalves(Reg v) { return _mm512_shuffle_f64x2(v, v, _MM_SHUFFLE(1, 0, 3, 2)); }   // [4..7, 0..3]
+
+        static Reg sortRegister(Reg v) {
+            v = exchange(v, swapPairs(v), 0xAA);
+            v = exchange(v, reverseQuads(v), 0xCC);
+            v = exchange(v, swapPairs(v), 0xAA);
+            v = exchange(v, reverse(v), 0xF0);
+            v = exchange(v, swapQuads(v), 0xCC);
+            return exchange(v, swapPairs(v), 0xAA);
+        }
+
+        static Reg cleanRegister(Reg v) {
+            v = exchange(v, swapHalves(v), 0xF0);
+            v = exchange(v, swapQuads(v), 0xCC);
+            return exchange(v, swapPairs(v), 0xAA);
+        }
+
+        // Compress-stores v's low lanes from lowEnd and its high lanes so they end at highBegin,
+        // returning the number of low lanes
+        static size_t partitionStore(double* lowEnd, double* highBegin, Reg v, Reg pivot, bool orEqual) {
+            __mmask8 lowLanes = orEqual ? _mm512_cmp_pd_mask(v, pivot, _CMP_LE_OQ) : _mm512_cmp_pd_mask(v, pivot, _CMP_LT_OQ);
+            size_t lows = countBits(lowLanes);
+            _mm512_mask_compressstoreu_pd(lowEnd, lowLanes, v);
+            _mm512_mask_compressstoreu_pd(highBegin - (LANES - lows), static_cast<__mmask8>(~lowLanes), v);
+            return lows;
+        }
+    };
+
+#include "simd_sort_kernels.inc"
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // SIMD_SORT_X86
+
+static SimdLevel detectSimdLevel() {
+#if SIMD_SORT_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+    if (!osSavesYmm) return SimdLevel::Scalar;
+
+    __cpuidex(info, 7, 0);
+    bool osSavesZmm = (_xgetbv(0) & 0xE6) == 0xE6;
+    if ((info[1] & (1 << 16)) && osSavesZmm) return SimdLevel::AVX512;
+    if (info[1] & (1 << 5)) return SimdLevel::AVX2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+#endif
+    return SimdLevel::Scalar;
+}
+
+SimdLevel detectedSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::AVX512: return "AVX-512";
+        default: return "Scalar";
+    }
+}
+
+void simdSort(std::vector<double>& data, SimdLevel level) {
+    if (data.size() <= 1) return;
+
+    switch (std::min(level, detectedSimdLevel())) {
+#if SIMD_SORT_X86
+        case SimdLevel::AVX512:
+            SimdAvx512::sort(data.data(), data.size());
+            return;
+        case SimdLevel::AVX2:
+            SimdAvx2::sort(data.data(), data.size());
+            return;
+#endif
+        default:
+            std::sort(data.begin(), data.end());
+            return;
+    }
+}
+
+void simdSort(std::vector<double>& data) {
+    simdSort(data, detectedSimdLevel());
+}
+
+void simdSortSmall(double* data, size_t n) {
+    switch (detectedSimdLevel()) {
+#if SIMD_SORT_X86
+        case SimdLevel::AVX512:
+            if (n <= SimdAvx512::NETWORK_MAX) return SimdAvx512::sortNetwork(data, n);
+            return SimdAvx512::sort(data, n);
+        case SimdLevel::AVX2:
+            if (n <= SimdAvx2::NETWORK_MAX) return SimdAvx2::sortNetwork(data, n);
+            return SimdAvx2::sort(data, n);
+#endif
+        default:
+            std::sort(data, data + n);
+            return;
+    }
+}
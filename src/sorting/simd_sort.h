@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+// Instruction sets simdSort can run on, in increasing order of width
+enum class SimdLevel {
+    Scalar,     // No vector code; falls back to std::sort
+    AVX2,       // 4 doubles per register
+    AVX512      // 8 doubles per register
+};
+
+// Widest level the running CPU (and OS) supports, detected once on first use
+SimdLevel detectedSimdLevel();
+const char* simdLevelName(SimdLevel level);
+
+// Quicksort with vectorized partitioning that finishes blocks of up to 8 registers (32 doubles
+// on AVX2, 64 on AVX-512) with an in-register bitonic sorting network. Dispatches at runtime to
+// the widest supported level; the overload taking a level uses at most that level, so every
+// path can be exercised on a wide machine. Values must not be NaN.
+void simdSort(std::vector<double>& data);
+void simdSort(std::vector<double>& data, SimdLevel level);
+
+// Sorts one small block, such as a rolling window, with the sorting network alone.
+// Blocks longer than the network fall back to simdSort.
+void simdSortSmall(double* data, size_t n);
@@ -1,4 +1,7 @@
 #include "sorting_analysis.h"
+#include "sorting_benchmark.h"
+#include "simd_sort.h"
+#include "../core/parallel.h"
 #include <algorithm>
 #include <chrono>
 #include <iostream>
@@ -7,6 +10,8 @@
 #include <iomanip> 
 #include <cmath>
 #include <fstream>
+#include <cstdint>
+#include <cstring>
 
 void selectionSort(std::vector<double>& data) {
     size_t n = data.size();
@@ -74,23 +79,340 @@ void mergeSort(std::vector<double>& arr, size_t left, size_t right) {
     merge(arr, left, mid, right);
 }
 
-void heapify(std::vector<double>& data, size_t n, size_t i) {
-    size_t largest = i; // Initialize largest as root
-    size_t left = 2 * i + 1;
-    size_t right = 2 * i + 2;
+// Runs at or below this length are sorted by insertion sort instead of being split further
+static const size_t INSERTION_SORT_CUTOFF = 32;
+
+// Smallest chunk handed to a worker thread; below this, thread start-up outweighs the work
+static const size_t PARALLEL_CHUNK_MIN = 1 << 15;
+
+static void insertionSort(double* first, double* last) {
+    for (double* i = first + 1; i < last; ++i) {
+        double value = *i;
+        double* j = i;
+        while (j > first && value < *(j - 1)) {
+            *j = *(j - 1);
+            --j;
+        }
+        *j = value;
+    }
+}
+
+// Stable merge of two sorted runs into out; equal elements are taken from the first run
+static void mergeRuns(const double* a, const double* aEnd, const double* b, const double* bEnd, double* out) {
+    while (a < aEnd && b < bEnd) {
+        *out++ = (*b < *a) ? *b++ : *a++;
+    }
+    out = std::copy(a, aEnd, out);
+    std::copy(b, bEnd, out);
+}
+
+// Serial merge sort over n elements that ping-pongs between two buffers instead of allocating.
+// The sorted result is left in scratch if intoScratch is set, otherwise in data.
+static void sortInto(double* data, double* scratch, size_t n, bool intoScratch) {
+    if (n <= INSERTION_SORT_CUTOFF) {
+        insertionSort(data, data + n);
+        if (intoScratch) std::copy(data, data + n, scratch);
+        return;
+    }
+
+    // Sort both halves into the other buffer, then merge them back into the target
+    size_t mid = n / 2;
+    sortInto(data, scratch, mid, !intoScratch);
+    sortInto(data + mid, scratch + mid, n - mid, !intoScratch);
+
+    const double* source = intoScratch ? data : scratch;
+    double* target = intoScratch ? scratch : data;
+    mergeRuns(source, source + mid, source + mid, source + n, target);
+}
+
+// Number of elements taken from run a among the first `diagonal` outputs of merging a and b
+// (merge path partition), so separate threads can produce disjoint slices of one merge
+static size_t mergePathSplit(const double* a, size_t aLength, const double* b, size_t bLength, size_t diagonal) {
+    size_t low = diagonal > bLength ? diagonal - bLength : 0;
+    size_t high = std::min(diagonal, aLength);
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (!(b[diagonal - mid - 1] < a[mid])) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+void parallelMergeSort(std::vector<double>& data) {
+    const size_t n = data.size();
+    if (n <= 1) return;
+
+    std::vector<double> scratch(n);
+    const size_t workers = StockScanner::workerCount();
+
+    // Split into a power-of-two number of chunks, at least one per worker when the input is large enough
+    size_t chunks = 1;
+    while (chunks < workers && n / (chunks * 2) >= PARALLEL_CHUNK_MIN) {
+        chunks *= 2;
+    }
+    auto bound = [&](size_t chunk) { return chunk * n / chunks; };
+
+    StockScanner::parallelFor(chunks, [&](size_t chunk) {
+        size_t low = bound(chunk);
+        sortInto(data.data() + low, scratch.data() + low, bound(chunk + 1) - low, false);
+    });
+
+    // Merge neighbouring runs pairwise, alternating between the two buffers. Each merge is cut
+    // into slices along its merge path so every round keeps all workers busy.
+    double* source = data.data();
+    double* target = scratch.data();
+    for (size_t width = 1; width < chunks; width *= 2) {
+        const size_t pairs = chunks / (2 * width);
+        const size_t slices = std::max<size_t>(1, workers / pairs);
+
+        StockScanner::parallelFor(pairs * slices, [&](size_t task) {
+            const size_t pair = task / slices;
+            const size_t slice = task % slices;
+            const size_t low = bound(2 * pair * width);
+            const size_t mid = bound((2 * pair + 1) * width);
+            const size_t high = bound((2 * pair + 2) * width);
+
+            const double* a = source + low;
+            const double* b = source + mid;
+            const size_t aLength = mid - low;
+            const size_t bLength = high - mid;
+            const size_t total = aLength + bLength;
+            const size_t begin = slice * total / slices;
+            const size_t end = (slice + 1) * total / slices;
+
+            size_t aBegin = mergePathSplit(a, aLength, b, bLength, begin);
+            size_t aEnd = mergePathSplit(a, aLength, b, bLength, end);
+            mergeRuns(a + aBegin, a + aEnd, b + (begin - aBegin), b + (end - aEnd), target + low + begin);
+        });
+
+        std::swap(source, target);
+    }
+
+    if (source != data.data()) {
+        data.swap(scratch);
+    }
+}
+
+// Shortest run adaptiveMergeSort merges; shorter natural runs are extended with insertion sort
+static const size_t MIN_RUN = 32;
+
+// Consecutive wins by one side of a merge after which it switches to galloping
+static const size_t MIN_GALLOP = 7;
+
+// Number of leading elements of [first, first + length) satisfying pred, which must hold for a
+// prefix only. Probes 1, 2, 4, ... elements before a binary search, so it costs O(log answer).
+template <typename Pred>
+static size_t gallopLeading(const double* first, size_t length, Pred pred) {
+    size_t low = 0;
+    size_t high = 1;
+    while (high <= length && pred(first[high - 1])) {
+        low = high;
+        high *= 2;
+    }
+    high = std::min(high, length);
+    return std::partition_point(first + low, first + high, pred) - first;
+}
+
+// Number of trailing elements satisfying pred, which must hold for a suffix only; probes from the end
+template <typename Pred>
+static size_t gallopTrailing(const double* first, size_t length, Pred pred) {
+    size_t low = 0;
+    size_t high = 1;
+    while (high <= length && pred(first[length - high])) {
+        low = high;
+        high *= 2;
+    }
+    high = std::min(high, length);
+    const double* boundary = std::partition_point(first + length - high, first + length - low,
+                                                  [&](double value) { return !pred(value); });
+    return (first + length) - boundary;
+}
+
+// Merges [low, mid) and [mid, high) with the left run copied out, filling from the front
+static void mergeLow(double* data, size_t low, size_t mid, size_t high, double* buffer) {
+    double* a = buffer;
+    double* aEnd = std::copy(data + low, data + mid, buffer);
+    double* b = data + mid;
+    double* bEnd = data + high;
+    double* out = data + low;
+
+    while (a < aEnd && b < bEnd) {
+        // One element at a time until one side keeps winning
+        size_t aWins = 0, bWins = 0;
+        while (a < aEnd && b < bEnd && aWins < MIN_GALLOP && bWins < MIN_GALLOP) {
+            if (*b < *a) {
+                *out++ = *b++;
+                ++bWins;
+                aWins = 0;
+            } else {
+                *out++ = *a++;
+                ++aWins;
+                bWins = 0;
+            }
+        }
+
+        // Then move whole blocks while they stay long
+        size_t aBlock = MIN_GALLOP, bBlock = MIN_GALLOP;
+        while (a < aEnd && b < bEnd && (aBlock >= MIN_GALLOP || bBlock >= MIN_GALLOP)) {
+            const double key = *b;
+            aBlock = gallopLeading(a, aEnd - a, [key](double value) { return !(key < value); });
+            out = std::copy(a, a + aBlock, out);
+            a += aBlock;
+            if (a == aEnd) break;
+
+            const double pivot = *a;
+            bBlock = gallopLeading(b, bEnd - b, [pivot](double value) { return value < pivot; });
+            out = std::copy(b, b + bBlock, out);
+            b += bBlock;
+        }
+    }
+
+    // Whatever remains of the right run is already in place
+    std::copy(a, aEnd, out);
+}
+
+// Merges [low, mid) and [mid, high) with the right run copied out, filling from the back
+static void mergeHigh(double* data, size_t low, size_t mid, size_t high, double* buffer) {
+    double* aBegin = data + low;
+    double* a = data + mid;         // One past the next left element to place
+    double* bBegin = buffer;
+    double* b = std::copy(data + mid, data + high, buffer);
+    double* out = data + high;
+
+    while (a > aBegin && b > bBegin) {
+        size_t aWins = 0, bWins = 0;
+        while (a > aBegin && b > bBegin && aWins < MIN_GALLOP && bWins < MIN_GALLOP) {
+            // Ties go to the right run so equal elements keep their order
+            if (*(b - 1) < *(a - 1)) {
+                *--out = *--a;
+                ++aWins;
+                bWins = 0;
+            } else {
+                *--out = *--b;
+                ++bWins;
+                aWins = 0;
+            }
+        }
+
+        size_t aBlock = MIN_GALLOP, bBlock = MIN_GALLOP;
+        while (a > aBegin && b > bBegin && (aBlock >= MIN_GALLOP || bBlock >= MIN_GALLOP)) {
+            const double key = *(b - 1);
+            aBlock = gallopTrailing(aBegin, a - aBegin, [key](double value) { return key < value; });
+            out = std::copy_backward(a - aBlock, a, out);
+            a -= aBlock;
+            if (a == aBegin) break;
+
+            const double pivot = *(a - 1);
+            bBlock = gallopTrailing(bBegin, b - bBegin, [pivot](double value) { return !(value < pivot); });
+            out = std::copy_backward(b - bBlock, b, out);
+            b -= bBlock;
+        }
+    }
+
+    // Whatever remains of the left run is already in place
+    std::copy_backward(bBegin, b, out);
+}
+
+// Merges adjacent sorted runs [low, mid) and [mid, high), first trimming the elements already in place
+static void mergeAdjacentRuns(double* data, size_t low, size_t mid, size_t high, double* buffer) {
+    const double firstRight = data[mid];
+    low += gallopLeading(data + low, mid - low, [firstRight](double value) { return !(firstRight < value); });
+    if (low == mid) return;
+
+    const double lastLeft = data[mid - 1];
+    high -= gallopTrailing(data + mid, high - mid, [lastLeft](double value) { return !(value < lastLeft); });
+    if (mid == high) return;
 
-    if (left < n && data[left] > data[largest]) {
-        largest = left;
+    if (mid - low <= high - mid) {
+        mergeLow(data, low, mid, high, buffer);
+    } else {
+        mergeHigh(data, low, mid, high, buffer);
     }
+}
 
-    if (right < n && data[right] > data[largest]) {
-        largest = right;
+// End of the natural run starting at begin, extended to MIN_RUN elements when shorter.
+// A strictly descending run is reversed in place, which keeps the sort stable.
+static size_t nextRun(double* data, size_t begin, size_t n) {
+    size_t end = begin + 1;
+    if (end < n) {
+        if (data[end] < data[begin]) {
+            while (end < n && data[end] < data[end - 1]) ++end;
+            std::reverse(data + begin, data + end);
+        } else {
+            while (end < n && !(data[end] < data[end - 1])) ++end;
+        }
     }
 
-    if (largest != i) {
-        std::swap(data[i], data[largest]);
-        heapify(data, n, largest);
+    if (end - begin < MIN_RUN && end < n) {
+        end = std::min(n, begin + MIN_RUN);
+        insertionSort(data + begin, data + end);
     }
+    return end;
+}
+
+// Powersort merge priority of the boundary between runs [begin1, begin2) and [begin2, end2): the
+// depth at which their midpoints, scaled to [0, 1), first fall in different halves
+static unsigned nodePower(size_t begin1, size_t begin2, size_t end2, size_t n) {
+    uint64_t a = static_cast<uint64_t>(begin1) + begin2; // Twice the first midpoint
+    uint64_t b = static_cast<uint64_t>(begin2) + end2;   // Twice the second midpoint
+    const uint64_t scale = 2 * static_cast<uint64_t>(n);
+    unsigned power = 0;
+    while (true) {
+        ++power;
+        a *= 2;
+        b *= 2;
+        bool aBit = a >= scale;
+        bool bBit = b >= scale;
+        if (aBit != bBit) return power;
+        if (aBit) {
+            a -= scale;
+            b -= scale;
+        }
+    }
+}
+
+void adaptiveMergeSort(std::vector<double>& data) {
+    const size_t n = data.size();
+    if (n <= 1) return;
+
+    double* values = data.data();
+    std::vector<double> buffer(n / 2 + 1); // Each merge copies out its shorter run
+
+    // Pending runs with the power of the boundary to their right; powers along the stack increase
+    struct PendingRun {
+        size_t begin;
+        unsigned power;
+    };
+    std::vector<PendingRun> pending;
+
+    size_t begin = 0;
+    size_t end = nextRun(values, 0, n);
+    while (end < n) {
+        size_t nextEnd = nextRun(values, end, n);
+        unsigned power = nodePower(begin, end, nextEnd, n);
+
+        while (!pending.empty() && pending.back().power > power) {
+            mergeAdjacentRuns(values, pending.back().begin, begin, end, buffer.data());
+            begin = pending.back().begin;
+            pending.pop_back();
+        }
+        pending.push_back({begin, power});
+        begin = end;
+        end = nextEnd;
+    }
+
+    while (!pending.empty()) {
+        mergeAdjacentRuns(values, pending.back().begin, begin, n, buffer.data());
+        begin = pending.back().begin;
+        pending.pop_back();
+    }
+}
+
+void heapify(std::vector<double>& data, size_t n, size_t i) {
+    heapify(data, n, i, std::less<double>());
 }
 
 void heapSort(std::vector<double>& data) {
@@ -146,23 +468,88 @@ void countingSort(std::vector<double>& data) {
     }
 }
 
-void measureSortingPerformance(const std::vector<double>& data, SortFunction sortFunction, const std::string& algorithmName, size_t dataSize, const std::string& timeUnit, double conversionFactor,std::ofstream& outFile) {
+// Radix sort works on 11-bit digits: six passes cover all 64 bits of a double
+static const int RADIX_BITS = 11;
+static const size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+static const int RADIX_PASSES = (64 + RADIX_BITS - 1) / RADIX_BITS;
+
+// Maps a double to an unsigned integer with the same ordering. Positive values only need
+// their sign bit set; negative values have every bit flipped so larger magnitudes sort lower.
+static uint64_t orderedBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 63) ? ~bits : (bits | 0x8000000000000000ull);
+}
+
+// LSD radix sort of any record type by the ordered bits of its double key. All digit
+// histograms are built in one pass up front, passes where every key shares the same digit
+// are skipped, and records move between the input and a single scratch buffer.
+template <typename Record, typename KeyOf>
+static void radixSortRecords(std::vector<Record>& data, KeyOf keyOf) {
+    const size_t n = data.size();
+    if (n <= 1) return;
 
-    std::vector<double> dataCopy = data;
-    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<size_t> counts(RADIX_PASSES * RADIX_BUCKETS, 0);
+    for (const Record& record : data) {
+        uint64_t key = orderedBits(keyOf(record));
+        for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+            ++counts[pass * RADIX_BUCKETS + ((key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1))];
+        }
+    }
 
-    sortFunction(dataCopy);
+    std::vector<Record> scratch(n);
+    std::vector<Record>* source = &data;
+    std::vector<Record>* target = &scratch;
+    for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+        size_t* offsets = counts.data() + pass * RADIX_BUCKETS;
+        const int shift = pass * RADIX_BITS;
+
+        uint64_t firstDigit = (orderedBits(keyOf((*source)[0])) >> shift) & (RADIX_BUCKETS - 1);
+        if (offsets[firstDigit] == n) continue; // Every key has the same digit; this pass would not move anything
+
+        // Turn the digit counts into starting offsets
+        size_t total = 0;
+        for (size_t bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {
+            size_t count = offsets[bucket];
+            offsets[bucket] = total;
+            total += count;
+        }
 
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed = end - start;
+        for (const Record& record : *source) {
+            size_t digit = (orderedBits(keyOf(record)) >> shift) & (RADIX_BUCKETS - 1);
+            (*target)[offsets[digit]++] = record;
+        }
+        std::swap(source, target);
+    }
 
-    double displayTime = elapsed.count() * conversionFactor;
+    if (source != &data) {
+        data.swap(scratch);
+    }
+}
+
+void radixSort(std::vector<double>& data) {
+    radixSortRecords(data, [](double value) { return value; });
+}
+
+void radixSortPairs(std::vector<std::pair<double, size_t>>& data) {
+    radixSortRecords(data, [](const std::pair<double, size_t>& record) { return record.first; });
+}
+
+void measureSortingPerformance(const std::vector<double>& data, SortFunction sortFunction, const std::string& algorithmName, size_t dataSize, const std::string& timeUnit, double conversionFactor, std::ofstream& outFile) {
+
+    // Report the median of several timed runs after a warm-up run, so one noisy run does not decide the result
+    bool sorted = true;
+    std::vector<double> times = timeSortTrials(data, sortFunction, 1, SORT_ANALYSIS_TRIALS, sorted);
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+
+    double displayTime = times[times.size() / 2] / 1e6 * conversionFactor;
 
     // Print the results with data size information in a consistent format
     std::cout << std::setw(12) << dataSize
               << " | " << std::setw(15) << algorithmName
               << " | Time Taken: " << std::fixed << std::setprecision(3)
-              << std::setw(10) << displayTime << " " << timeUnit << std::endl;
+              << std::setw(10) << displayTime << " " << timeUnit
+              << (sorted ? "" : "  (NOT SORTED)") << std::endl;
 
     // Write to CSV
     if (outFile.is_open()) {
@@ -180,15 +567,16 @@ void runSortingAnalysis() {
         std::cerr << "Failed to open CSV file for writing. Results will not be saved.\n";
     }
     
-    std::vector<size_t> dataSizes = {100, 1000, 10000, 100000};
+    std::cout << "SimdSort instruction set: " << simdLevelName(detectedSimdLevel()) << "\n";
+
+    // Large inputs only run the algorithms whose registry cap allows them
+    std::vector<size_t> dataSizes = {100, 1000, 10000, 100000, 1000000, 10000000};
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(0.0, 100.0);
 
     for (size_t size : dataSizes) {
         // Generate random data
-        std::vector<double> data(size);
-        std::generate(data.begin(), data.end(), [&]() { return dis(gen); });
+        std::vector<double> data = generateSortInput(InputShape::Random, size, gen, {});
 
         // Use microseconds as timeUnit
         std::string timeUnit = "microseconds";
@@ -198,15 +586,15 @@ void runSortingAnalysis() {
         std::cout << "\nAnalyzing Sorting Performance for Data Size: " << size << "\n" << std::string(60, '-') << "\n";
 
         // Measure performance for each algorithm using consistent units for the current data size
-        measureSortingPerformance(data, selectionSort, "SelectionSort", size, timeUnit, conversionFactor, outFile);
-        measureSortingPerformance(data, [](std::vector<double>& d) { mergeSort(d, 0, d.size() - 1); }, "MergeSort", size, timeUnit, conversionFactor, outFile);
-        measureSortingPerformance(data, heapSort, "HeapSort", size, timeUnit, conversionFactor, outFile);
-        measureSortingPerformance(data, countingSort, "CountingSort", size, timeUnit, conversionFactor, outFile);
-        measureSortingPerformance(data, [](std::vector<double>& d) { std::sort(d.begin(), d.end()); }, "std::sort", size, timeUnit, conversionFactor, outFile);
+        for (const auto& algorithm : sortAlgorithms()) {
+            if (size <= algorithm.maxSize) {
+                measureSortingPerformance(data, algorithm.sort, algorithm.name, size, timeUnit, conversionFactor, outFile);
+            }
+        }
     }
 
     if (outFile.is_open()) {
         outFile.close();
         std::cout << "\nSorting analysis results saved to 'sorting_analysis_results.csv'.\n";
     }
-}
\ No newline at end of file
+}
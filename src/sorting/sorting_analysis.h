@@ -2,6 +2,9 @@
 
 #include <vector>
 #include <string>
+#include <iosfwd>
+#include <functional>
+#include <utility>
 
 using SortFunction = void(*)(std::vector<double>&);
 
@@ -10,10 +13,47 @@ void selectionSort(std::vector<double>& data);
 void mergeSort(std::vector<double>& arr, size_t left, size_t right);
 void heapSort(std::vector<double>& data);
 void countingSort(std::vector<double>& data);
+void parallelMergeSort(std::vector<double>& data);
 
-void measureSortingPerformance(const std::vector<double>& data, SortFunction sortFunction, const std::string& algorithmName);
+// Stable natural merge sort (powersort run policy with galloping merges); O(n) on sorted or
+// reverse-sorted input and close to it when only a few elements are out of place
+void adaptiveMergeSort(std::vector<double>& data);
+
+// Exact linear-time sorts for any doubles, including negative values and wide ranges.
+// radixSortPairs orders records by key and keeps equal keys in their original order.
+void radixSort(std::vector<double>& data);
+void radixSortPairs(std::vector<std::pair<double, size_t>>& data);
+
+// Number of timed runs behind each runSortingAnalysis measurement; the median is reported
+constexpr size_t SORT_ANALYSIS_TRIALS = 3;
+
+void measureSortingPerformance(const std::vector<double>& data, SortFunction sortFunction, const std::string& algorithmName,
+                               size_t dataSize, const std::string& timeUnit, double conversionFactor, std::ofstream& outFile);
 void runSortingAnalysis();
 
 // Helper functions
 void merge(std::vector<double>& data, size_t left, size_t mid, size_t right);
-void heapify(std::vector<double>& data, size_t n, size_t i);
\ No newline at end of file
+void heapify(std::vector<double>& data, size_t n, size_t i);
+
+// Sifts data[i] down within the first n elements so the subtree rooted at i is a heap whose
+// root is the greatest element under compare. heapify above is this with std::less<double>.
+template <typename T, typename Compare>
+void heapify(std::vector<T>& data, size_t n, size_t i, Compare compare) {
+    while (true) {
+        size_t largest = i;
+        size_t left = 2 * i + 1;
+        size_t right = 2 * i + 2;
+
+        if (left < n && compare(data[largest], data[left])) {
+            largest = left;
+        }
+
+        if (right < n && compare(data[largest], data[right])) {
+            largest = right;
+        }
+
+        if (largest == i) return;
+        std::swap(data[i], data[largest]);
+        i = largest;
+    }
+}
\ No newline at end of file
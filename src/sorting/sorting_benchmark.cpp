@@ -0,0 +1,313 @@
+#include "sorting_benchmark.h"
+#include "simd_sort.h"
+#include "../database/database_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+const std::vector<SortAlgorithm>& sortAlgorithms() {
+    static const std::vector<SortAlgorithm> algorithms = {
+        {"SelectionSort", selectionSort, 100000},
+        {"MergeSort", [](std::vector<double>& d) { if (!d.empty()) mergeSort(d, 0, d.size() - 1); }, SIZE_MAX},
+        {"HeapSort", heapSort, SIZE_MAX},
+        {"CountingSort", countingSort, 100000},
+        {"ParallelMerge", parallelMergeSort, SIZE_MAX},
+        {"AdaptiveMerge", adaptiveMergeSort, SIZE_MAX},
+        {"RadixSort", radixSort, SIZE_MAX},
+        {"SimdSort", simdSort, SIZE_MAX},
+        {"std::sort", [](std::vector<double>& d) { std::sort(d.begin(), d.end()); }, SIZE_MAX}
+    };
+    return algorithms;
+}
+
+static const std::vector<std::pair<InputShape, std::string>> SHAPE_NAMES = {
+    {InputShape::Random, "random"},
+    {InputShape::Sorted, "sorted"},
+    {InputShape::Reverse, "reverse"},
+    {InputShape::NearlySorted, "nearly_sorted"},
+    {InputShape::ManyDuplicates, "duplicates"},
+    {InputShape::ClosePrices, "close_prices"}
+};
+
+std::vector<InputShape> allInputShapes() {
+    std::vector<InputShape> shapes;
+    for (const auto& [shape, name] : SHAPE_NAMES) shapes.push_back(shape);
+    return shapes;
+}
+
+std::string inputShapeName(InputShape shape) {
+    for (const auto& [value, name] : SHAPE_NAMES) {
+        if (value == shape) return name;
+    }
+    return "unknown";
+}
+
+bool parseInputShape(const std::string& name, InputShape& shape) {
+    for (const auto& [value, shapeName] : SHAPE_NAMES) {
+        if (shapeName == name) {
+            shape = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<double> generateSortInput(InputShape shape, size_t size, std::mt19937& gen,
+                                      const std::vector<double>& closePrices) {
+    std::vector<double> data(size);
+    std::uniform_real_distribution<> dis(0.0, 100.0);
+
+    switch (shape) {
+        case InputShape::Random:
+            std::generate(data.begin(), data.end(), [&]() { return dis(gen); });
+            break;
+        case InputShape::Sorted:
+        case InputShape::Reverse:
+        case InputShape::NearlySorted:
+            std::generate(data.begin(), data.end(), [&]() { return dis(gen); });
+            std::sort(data.begin(), data.end());
+            if (shape == InputShape::Reverse) {
+                std::reverse(data.begin(), data.end());
+            } else if (shape == InputShape::NearlySorted && size > 1) {
+                // Displace about 1% of the elements, mostly over short distances like late-arriving bars
+                std::uniform_int_distribution<size_t> position(0, size - 1);
+                std::uniform_int_distribution<size_t> distance(1, 16);
+                for (size_t swaps = std::max<size_t>(1, size / 100); swaps > 0; --swaps) {
+                    size_t i = position(gen);
+                    size_t j = std::min(size - 1, i + distance(gen));
+                    std::swap(data[i], data[j]);
+                }
+            }
+            break;
+        case InputShape::ManyDuplicates: {
+            std::uniform_int_distribution<int> value(0, 15);
+            std::generate(data.begin(), data.end(), [&]() { return static_cast<double>(value(gen)); });
+            break;
+        }
+        case InputShape::ClosePrices:
+            // Repeat the stored series in order, which keeps its real value distribution and runs
+            if (closePrices.empty()) return {};
+            for (size_t i = 0; i < size; ++i) {
+                data[i] = closePrices[i % closePrices.size()];
+            }
+            break;
+    }
+    return data;
+}
+
+std::vector<double> timeSortTrials(const std::vector<double>& data, SortFunction sortFunction,
+                                   size_t warmupRuns, size_t trials, bool& sorted) {
+    std::vector<double> times;
+    times.reserve(trials);
+    sorted = true;
+
+    for (size_t run = 0; run < warmupRuns + trials; ++run) {
+        std::vector<double> dataCopy = data;
+
+        auto start = std::chrono::steady_clock::now();
+        sortFunction(dataCopy);
+        auto end = std::chrono::steady_clock::now();
+
+        sorted = sorted && std::is_sorted(dataCopy.begin(), dataCopy.end());
+        if (run >= warmupRuns) {
+            times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+    }
+    return times;
+}
+
+// Value at the given percentile (0-100) of the samples using the nearest-rank method
+static double percentileOf(std::vector<double> samples, double percentile) {
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * samples.size()));
+    return samples[std::min(samples.size() - 1, rank == 0 ? 0 : rank - 1)];
+}
+
+static SortBenchmarkResult summarize(const std::string& algorithm, InputShape shape, size_t size,
+                                     const std::vector<double>& times, bool sorted) {
+    SortBenchmarkResult result{algorithm, shape, size, times.size(), 0.0, 0.0, 0.0, 0.0, sorted};
+    if (!times.empty()) {
+        result.minimum = *std::min_element(times.begin(), times.end());
+        result.median = percentileOf(times, 50.0);
+        result.p95 = percentileOf(times, 95.0);
+        double total = 0.0;
+        for (double time : times) total += time;
+        result.mean = total / times.size();
+    }
+    return result;
+}
+
+static void writeCsv(const std::string& path, const std::vector<SortBenchmarkResult>& results) {
+    std::ofstream outFile(path);
+    if (!outFile.is_open()) {
+        std::cerr << "Failed to open " << path << " for writing.\n";
+        return;
+    }
+
+    outFile << "algorithm,shape,size,trials,min_us,median_us,p95_us,mean_us,sorted\n";
+    for (const auto& result : results) {
+        outFile << result.algorithm << "," << inputShapeName(result.shape) << "," << result.size << ","
+                << result.trials << "," << result.minimum << "," << result.median << ","
+                << result.p95 << "," << result.mean << "," << (result.sorted ? "true" : "false") << "\n";
+    }
+}
+
+static void writeJson(const std::string& path, const SortBenchmarkConfig& config,
+                      const std::vector<SortBenchmarkResult>& results) {
+    std::ofstream outFile(path);
+    if (!outFile.is_open()) {
+        std::cerr << "Failed to open " << path << " for writing.\n";
+        return;
+    }
+
+    outFile << "{\n  \"warmup_runs\": " << config.warmupRuns << ",\n  \"trials\": " << config.trials
+            << ",\n  \"unit\": \"microseconds\",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        outFile << (i == 0 ? "\n" : ",\n")
+                << "    {\"algorithm\": \"" << result.algorithm << "\", \"shape\": \"" << inputShapeName(result.shape)
+                << "\", \"size\": " << result.size << ", \"trials\": " << result.trials
+                << ", \"min\": " << result.minimum << ", \"median\": " << result.median
+                << ", \"p95\": " << result.p95 << ", \"mean\": " << result.mean
+                << ", \"sorted\": " << (result.sorted ? "true" : "false") << "}";
+    }
+    outFile << "\n  ]\n}\n";
+}
+
+std::vector<SortBenchmarkResult> runSortBenchmark(const SortBenchmarkConfig& config) {
+    // Resolve the selected algorithms, keeping registry order
+    std::vector<SortAlgorithm> selected;
+    for (const auto& algorithm : sortAlgorithms()) {
+        if (config.algorithms.empty() ||
+            std::find(config.algorithms.begin(), config.algorithms.end(), algorithm.name) != config.algorithms.end()) {
+            selected.push_back(algorithm);
+        }
+    }
+
+    std::vector<double> closePrices;
+    if (std::find(config.shapes.begin(), config.shapes.end(), InputShape::ClosePrices) != config.shapes.end()) {
+        closePrices = StockScanner::getAllClosePricesFromDatabase();
+        if (closePrices.empty()) {
+            std::cerr << "No close prices in the database; skipping the close_prices shape.\n";
+        }
+    }
+
+    std::mt19937 gen(12345); // Fixed seed so every run benchmarks the same inputs
+    std::vector<SortBenchmarkResult> results;
+
+    std::cout << "SimdSort instruction set: " << simdLevelName(detectedSimdLevel()) << "\n\n";
+    std::cout << std::setw(15) << "Algorithm" << " | " << std::setw(13) << "Shape" << " | " << std::setw(10) << "Size"
+              << " | " << std::setw(12) << "Min (us)" << " | " << std::setw(12) << "Median (us)"
+              << " | " << std::setw(12) << "P95 (us)" << "\n" << std::string(90, '-') << "\n";
+
+    for (InputShape shape : config.shapes) {
+        for (size_t size : config.sizes) {
+            std::vector<double> data = generateSortInput(shape, size, gen, closePrices);
+            if (data.size() != size) continue; // Shape unavailable
+
+            for (const auto& algorithm : selected) {
+                if (size > algorithm.maxSize) continue;
+
+                bool sorted = true;
+                std::vector<double> times = timeSortTrials(data, algorithm.sort, config.warmupRuns, config.trials, sorted);
+                SortBenchmarkResult result = summarize(algorithm.name, shape, size, times, sorted);
+                results.push_back(result);
+
+                std::cout << std::setw(15) << result.algorithm << " | " << std::setw(13) << inputShapeName(shape)
+                          << " | " << std::setw(10) << size << std::fixed << std::setprecision(3)
+                          << " | " << std::setw(12) << result.minimum << " | " << std::setw(12) << result.median
+                          << " | " << std::setw(12) << result.p95 << (sorted ? "" : "  (NOT SORTED)") << "\n";
+            }
+        }
+    }
+
+    writeCsv(config.outputPrefix + ".csv", results);
+    writeJson(config.outputPrefix + ".json", config, results);
+    std::cout << "\nSorting benchmark results saved to '" << config.outputPrefix << ".csv' and '"
+              << config.outputPrefix << ".json'.\n";
+    return results;
+}
+
+// Splits a comma-separated option value
+static std::vector<std::string> splitList(const std::string& value) {
+    std::vector<std::string> items;
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+static void printSortBenchmarkUsage() {
+    std::cerr << "Usage: StockScanner --sort-benchmark [--algorithms=a,b] [--shapes=s1,s2] [--sizes=n1,n2]\n"
+              << "                    [--trials=N] [--warmup=N] [--output=prefix]\n"
+              << "Algorithms:";
+    for (const auto& algorithm : sortAlgorithms()) std::cerr << " " << algorithm.name;
+    std::cerr << "\nShapes:";
+    for (const auto& [shape, name] : SHAPE_NAMES) std::cerr << " " << name;
+    std::cerr << "\n";
+}
+
+bool parseSortBenchmarkArgs(int argc, char* argv[], SortBenchmarkConfig& config) {
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--sort-benchmark") continue;
+
+            size_t equals = arg.find('=');
+            std::string option = arg.substr(0, equals);
+            std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+
+            if (option == "--algorithms") {
+                config.algorithms = splitList(value);
+                for (const auto& name : config.algorithms) {
+                    auto known = std::find_if(sortAlgorithms().begin(), sortAlgorithms().end(),
+                                              [&](const SortAlgorithm& algorithm) { return algorithm.name == name; });
+                    if (known == sortAlgorithms().end()) {
+                        std::cerr << "Unknown algorithm: " << name << "\n";
+                        printSortBenchmarkUsage();
+                        return false;
+                    }
+                }
+            } else if (option == "--shapes") {
+                config.shapes.clear();
+                for (const auto& name : splitList(value)) {
+                    InputShape shape;
+                    if (!parseInputShape(name, shape)) {
+                        std::cerr << "Unknown shape: " << name << "\n";
+                        printSortBenchmarkUsage();
+                        return false;
+                    }
+                    config.shapes.push_back(shape);
+                }
+            } else if (option == "--sizes") {
+                config.sizes.clear();
+                for (const auto& size : splitList(value)) {
+                    config.sizes.push_back(std::stoull(size));
+                }
+            } else if (option == "--trials") {
+                config.trials = std::stoull(value);
+            } else if (option == "--warmup") {
+                config.warmupRuns = std::stoull(value);
+            } else if (option == "--output" && !value.empty()) {
+                config.outputPrefix = value;
+            } else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                printSortBenchmarkUsage();
+                return false;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric option value.\n";
+        printSortBenchmarkUsage();
+        return false;
+    }
+    return true;
+}
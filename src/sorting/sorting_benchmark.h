@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <random>
+#include "sorting_analysis.h"
+
+// A sorting algorithm available to the benchmark harness
+struct SortAlgorithm {
+    std::string name;
+    SortFunction sort;
+    size_t maxSize;     // Largest input the algorithm is run on (caps the quadratic and range-limited sorts)
+};
+
+// Shapes of benchmark input
+enum class InputShape {
+    Random,         // Uniform in [0, 100)
+    Sorted,         // Already ascending
+    Reverse,        // Descending
+    NearlySorted,   // Ascending with about 1% of elements displaced
+    ManyDuplicates, // Only 16 distinct values
+    ClosePrices     // Real close prices from stock_data.db, repeated to the requested size
+};
+
+struct SortBenchmarkConfig {
+    std::vector<std::string> algorithms;    // Names from sortAlgorithms(); empty runs all
+    std::vector<InputShape> shapes = {InputShape::Random, InputShape::NearlySorted};
+    std::vector<size_t> sizes = {1000, 100000, 1000000};
+    size_t warmupRuns = 1;
+    size_t trials = 5;
+    std::string outputPrefix = "sorting_benchmark_results"; // Writes <prefix>.csv and <prefix>.json
+};
+
+// Timing summary for one (algorithm, shape, size) cell, in microseconds
+struct SortBenchmarkResult {
+    std::string algorithm;
+    InputShape shape;
+    size_t size;
+    size_t trials;
+    double minimum;
+    double median;
+    double p95;
+    double mean;
+    bool sorted;        // Whether every trial produced sorted output
+};
+
+// Every algorithm the harness and runSortingAnalysis know about
+const std::vector<SortAlgorithm>& sortAlgorithms();
+
+std::vector<InputShape> allInputShapes();
+std::string inputShapeName(InputShape shape);
+bool parseInputShape(const std::string& name, InputShape& shape);
+
+// Builds an input of the given shape; closePrices supplies the ClosePrices shape
+std::vector<double> generateSortInput(InputShape shape, size_t size, std::mt19937& gen,
+                                      const std::vector<double>& closePrices);
+
+// Times warmupRuns untimed runs followed by trials timed runs, each on a fresh copy of data.
+// Returns the trial times in microseconds; sorted is cleared if any run left data unsorted.
+std::vector<double> timeSortTrials(const std::vector<double>& data, SortFunction sortFunction,
+                                   size_t warmupRuns, size_t trials, bool& sorted);
+
+// Runs every selected (algorithm, shape, size) cell, prints a summary table and writes the CSV and JSON files
+std::vector<SortBenchmarkResult> runSortBenchmark(const SortBenchmarkConfig& config);
+
+// Parses --algorithms=a,b --shapes=random,sorted --sizes=1000,1000000 --trials=N --warmup=N --output=prefix.
+// Returns false and prints usage on an unknown option or value.
+bool parseSortBenchmarkArgs(int argc, char* argv[], SortBenchmarkConfig& config);
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include "sorting_analysis.h"
+#include "../core/symbol_table.h"
+
+// One scan result to rank, e.g. a ticker's interned ID and its percent move or momentum strength
+struct ScanRecord {
+    StockScanner::SymbolId symbol;
+    double metric;
+
+    bool operator==(const ScanRecord& other) const { return symbol == other.symbol && metric == other.metric; }
+};
+
+// Orders records by metric; equal metrics rank the lower symbol ID (the one interned first) higher
+struct MetricLess {
+    bool operator()(const ScanRecord& a, const ScanRecord& b) const {
+        return a.metric < b.metric || (a.metric == b.metric && a.symbol > b.symbol);
+    }
+};
+
+// Reverse of MetricLess, so the "top" records are the ones with the lowest metric
+struct MetricGreater {
+    bool operator()(const ScanRecord& a, const ScanRecord& b) const {
+        return MetricLess()(b, a);
+    }
+};
+
+// Keeps the k greatest values (under Compare) seen in a stream in O(log k) per value.
+// The kept values sit in a heap whose root is the weakest of them, so a new value only
+// has to beat the root to get in; nothing beyond k values is ever stored.
+template <typename T, typename Compare = std::less<T>>
+class TopKSelector {
+public:
+    explicit TopKSelector(size_t k, Compare compare = Compare()) : k(k), compare(compare) {
+        heap.reserve(k);
+    }
+
+    void push(const T& value) {
+        if (heap.size() < k) {
+            heap.push_back(value);
+            if (heap.size() == k) {
+                // Heapify once the selector fills, then sift each replacement down from the root
+                for (size_t i = k / 2; i > 0; --i) {
+                    heapify(heap, k, i - 1, weakerFirst());
+                }
+            }
+        } else if (k > 0 && compare(heap[0], value)) {
+            heap[0] = value;
+            heapify(heap, k, 0, weakerFirst());
+        }
+    }
+
+    template <typename Iterator>
+    void pushRange(Iterator first, Iterator last) {
+        for (; first != last; ++first) push(*first);
+    }
+
+    size_t size() const { return heap.size(); }
+    size_t capacity() const { return k; }
+    bool empty() const { return heap.empty(); }
+    void clear() { heap.clear(); }
+
+    // The kept values, best first
+    std::vector<T> results() const {
+        std::vector<T> sorted = heap;
+        std::sort(sorted.begin(), sorted.end(), [this](const T& a, const T& b) { return compare(b, a); });
+        return sorted;
+    }
+
+private:
+    size_t k;
+    Compare compare;
+    std::vector<T> heap;
+
+    // Heap order with the weakest kept value at the root
+    auto weakerFirst() const {
+        return [this](const T& a, const T& b) { return compare(b, a); };
+    }
+};
+
+// Batch selection of the k greatest values (under compare), best first, in O(n + k log k)
+template <typename T, typename Compare = std::less<T>>
+std::vector<T> selectTopK(std::vector<T> values, size_t k, Compare compare = Compare()) {
+    auto better = [&compare](const T& a, const T& b) { return compare(b, a); };
+    if (k < values.size()) {
+        std::nth_element(values.begin(), values.begin() + k, values.end(), better);
+        values.resize(k);
+    }
+    std::sort(values.begin(), values.end(), better);
+    return values;
+}
+
+// The k records with the highest metric, highest first
+inline std::vector<ScanRecord> topK(const std::vector<ScanRecord>& records, size_t k) {
+    return selectTopK(records, k, MetricLess());
+}
+
+// The k records with the lowest metric, lowest first
+inline std::vector<ScanRecord> bottomK(const std::vector<ScanRecord>& records, size_t k) {
+    return selectTopK(records, k, MetricGreater());
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include "../src/bplus_tree/bplus_tree.h"
+
+// Minute bars over trading hours, as (timestamp, bar offset) pairs in arrival order
+static std::vector<std::pair<int64_t, uint32_t>> minuteBars(size_t count) {
+    std::vector<std::pair<int64_t, uint32_t>> bars;
+    bars.reserve(count);
+    const int64_t sessionOpen = 1730453400;    // 2024-11-01 09:30:00
+    for (size_t i = 0; i < count; ++i) {
+        int64_t day = static_cast<int64_t>(i / 390);
+        int64_t minute = static_cast<int64_t>(i % 390);
+        bars.emplace_back(sessionOpen + day * 86400 + minute * 60, static_cast<uint32_t>(i));
+    }
+    return bars;
+}
+
+// Functionality Tests
+TEST(BPlusTreeTests, EmptyTree) {
+    TimestampIndex index;
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.getHeight(), 0u);
+    EXPECT_FALSE(index.retrieve(42).has_value());
+    EXPECT_TRUE(index.begin() == index.end());
+    EXPECT_TRUE(index.lowerBound(42) == index.end());
+    EXPECT_THROW(index.minimumKey(), std::out_of_range);
+    EXPECT_TRUE(index.isValid());
+}
+
+TEST(BPlusTreeTests, MatchesMapUnderRandomInserts) {
+    BPlusTree<int64_t, uint32_t, 128> tree;   // Small nodes so the tree grows several levels
+    std::map<int64_t, uint32_t> reference;
+    std::mt19937_64 gen(11);
+    std::uniform_int_distribution<int64_t> keys(-5000, 5000);
+
+    for (uint32_t i = 0; i < 20000; ++i) {
+        int64_t key = keys(gen);
+        tree.insert(key, i);
+        reference[key] = i;
+    }
+
+    ASSERT_TRUE(tree.isValid());
+    ASSERT_EQ(tree.getSize(), reference.size());
+    EXPECT_GE(tree.getHeight(), 3u);
+    EXPECT_EQ(tree.minimumKey(), reference.begin()->first);
+    EXPECT_EQ(tree.maximumKey(), reference.rbegin()->first);
+
+    auto expected = reference.begin();
+    for (auto it = tree.begin(); it != tree.end(); ++it, ++expected) {
+        ASSERT_EQ(it.key(), expected->first);
+        ASSERT_EQ(it.value(), expected->second);
+    }
+    for (int64_t key = -5010; key <= 5010; key += 7) {
+        auto found = tree.retrieve(key);
+        auto referenceFound = reference.find(key);
+        ASSERT_EQ(found.has_value(), referenceFound != reference.end());
+        if (found) {
+            ASSERT_EQ(*found, referenceFound->second);
+        }
+
+        auto lower = tree.lowerBound(key);
+        auto referenceLower = reference.lower_bound(key);
+        ASSERT_EQ(lower == tree.end(), referenceLower == reference.end());
+        if (referenceLower != reference.end()) {
+            ASSERT_EQ(lower.key(), referenceLower->first);
+        }
+
+        auto upper = tree.upperBound(key);
+        auto referenceUpper = reference.upper_bound(key);
+        ASSERT_EQ(upper == tree.end(), referenceUpper == reference.end());
+        if (referenceUpper != reference.end()) {
+            ASSERT_EQ(upper.key(), referenceUpper->first);
+        }
+    }
+}
+
+TEST(BPlusTreeTests, AppendsPackLeavesFully) {
+    auto bars = minuteBars(100000);
+    TimestampIndex index;
+    for (const auto& [timestamp, offset] : bars) {
+        index.insert(timestamp, offset);
+    }
+
+    ASSERT_TRUE(index.isValid());
+    EXPECT_EQ(index.getSize(), bars.size());
+    // Appends fill each node before starting the next, so the tree is as shallow as a fully packed bulk load
+    TimestampIndex bulk;
+    bulk.bulkLoad(bars.begin(), bars.end());
+    ASSERT_TRUE(bulk.isValid());
+    EXPECT_EQ(index.getHeight(), bulk.getHeight());
+    EXPECT_EQ(index.getHeight(), 4u);   // 41 bars per leaf, 32 children per inner node
+
+    // Overwriting an existing bar keeps the size
+    index.insert(bars[500].first, 7);
+    EXPECT_EQ(index.getSize(), bars.size());
+    EXPECT_EQ(index.retrieve(bars[500].first), 7u);
+}
+
+TEST(BPlusTreeTests, BulkLoadAndRangeScan) {
+    auto bars = minuteBars(5000);
+    TimestampIndex index;
+    index.bulkLoad(bars.begin(), bars.end(), 0.7);
+    ASSERT_TRUE(index.isValid());
+    EXPECT_EQ(index.getSize(), bars.size());
+    EXPECT_EQ(index.minimumKey(), bars.front().first);
+    EXPECT_EQ(index.maximumKey(), bars.back().first);
+
+    // The second session, bounded by timestamps that fall between bars
+    int64_t low = bars[390].first - 30;
+    int64_t high = bars[779].first + 30;
+    std::vector<uint32_t> offsets;
+    index.forEachInRange(low, high, [&](int64_t, uint32_t offset) { offsets.push_back(offset); });
+    ASSERT_EQ(offsets.size(), 390u);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        EXPECT_EQ(offsets[i], 390 + i);
+    }
+
+    size_t visited = 0;
+    index.forEachInRange(high, low, [&](int64_t, uint32_t) { ++visited; });
+    EXPECT_EQ(visited, 0u);
+
+    // Inserts after a partial-fill bulk load land in the spare room and keep the tree valid
+    for (size_t i = 0; i < bars.size(); i += 10) {
+        index.insert(bars[i].first + 1, static_cast<uint32_t>(i));
+    }
+    EXPECT_TRUE(index.isValid());
+    EXPECT_EQ(index.getSize(), bars.size() + 500);
+}
+
+TEST(BPlusTreeTests, BulkLoadRejectsUnsortedInput) {
+    std::vector<std::pair<int64_t, uint32_t>> bars = {{1, 0}, {3, 1}, {2, 2}};
+    TimestampIndex index;
+    EXPECT_THROW(index.bulkLoad(bars.begin(), bars.end()), std::invalid_argument);
+    EXPECT_TRUE(index.empty());
+    EXPECT_TRUE(index.isValid());
+
+    std::vector<std::pair<int64_t, uint32_t>> duplicated = {{1, 0}, {1, 1}};
+    EXPECT_THROW(index.bulkLoad(duplicated.begin(), duplicated.end()), std::invalid_argument);
+    EXPECT_THROW(index.bulkLoad(duplicated.begin(), duplicated.end(), 0.0), std::invalid_argument);
+}
+
+// Performance Tests
+TEST(BPlusTreePerformanceTests, RangeScanVersusMap) {
+    std::cout << "\nTimestamp index vs std::map (ns per operation, scans per bar visited):\n";
+    std::cout << std::setw(10) << "Bars" << " | " << std::setw(18) << "Structure" << " | " << std::setw(8) << "Append"
+              << " | " << std::setw(8) << "Lookup" << " | " << std::setw(8) << "Scan\n";
+
+    for (size_t n : {10000, 100000, 1000000}) {
+        auto bars = minuteBars(n);
+        std::mt19937 gen(3);
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        std::vector<int64_t> probes(100000);
+        for (auto& probe : probes) probe = bars[pick(gen)].first;
+        const size_t scanLength = 390;  // One session of minute bars
+
+        auto timeIt = [](auto&& body, size_t operations) {
+            auto start = std::chrono::high_resolution_clock::now();
+            body();
+            auto end = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double, std::nano>(end - start).count() / operations;
+        };
+
+        uint64_t checksum = 0;
+        TimestampIndex tree;
+        double treeAppend = timeIt([&] { for (const auto& [t, o] : bars) tree.insert(t, o); }, n);
+        double treeLookup = timeIt([&] { for (int64_t probe : probes) checksum += *tree.retrieve(probe); }, probes.size());
+        double treeScan = timeIt([&] {
+            for (size_t i = 0; i < 1000; ++i) {
+                int64_t low = probes[i];
+                size_t seen = 0;
+                for (auto it = tree.lowerBound(low); it != tree.end() && seen < scanLength; ++it, ++seen) checksum += it.value();
+            }
+        }, 1000 * scanLength);
+
+        std::map<int64_t, uint32_t> map;
+        double mapAppend = timeIt([&] { for (const auto& [t, o] : bars) map.emplace_hint(map.end(), t, o); }, n);
+        double mapLookup = timeIt([&] { for (int64_t probe : probes) checksum += map.find(probe)->second; }, probes.size());
+        double mapScan = timeIt([&] {
+            for (size_t i = 0; i < 1000; ++i) {
+                int64_t low = probes[i];
+                size_t seen = 0;
+                for (auto it = map.lower_bound(low); it != map.end() && seen < scanLength; ++it, ++seen) checksum += it->second;
+            }
+        }, 1000 * scanLength);
+
+        for (const auto& [label, times] : {std::make_pair("BPlusTree", std::vector<double>{treeAppend, treeLookup, treeScan}),
+                                           std::make_pair("std::map", std::vector<double>{mapAppend, mapLookup, mapScan})}) {
+            std::cout << std::setw(10) << n << " | " << std::setw(18) << label << std::fixed << std::setprecision(1);
+            for (double time : times) std::cout << " | " << std::setw(8) << time;
+            std::cout << "\n";
+        }
+        EXPECT_GT(checksum, 0u);
+    }
+}
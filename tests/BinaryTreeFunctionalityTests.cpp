@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 #include "../src/binary_tree/binary_tree.h"
+#include "../src/binary_tree/balanced_binary_tree.h"
+#include <cmath>
 #include <sstream>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <string>
 
 // Functionality Tests
 TEST(BinaryTreeFunctionalityTests, AddAndFind) {
@@ -155,3 +161,296 @@ TEST(BinaryTreeEdgeCaseTests, UnbalancedTree) {
 
     EXPECT_EQ(output.str(), "1 2 3 4 5 \n");
 }
+
+// Order-Statistic Tests
+TEST(BinaryTreeOrderStatisticTests, RankAndSelect) {
+    BinaryTree bst;
+    for (int value : {50, 30, 70, 20, 40, 60, 80}) {
+        bst.Add(value);
+    }
+
+    EXPECT_EQ(bst.Size(), 7);
+    EXPECT_EQ(bst.Rank(20), 0);
+    EXPECT_EQ(bst.Rank(55), 4);  // 20, 30, 40 and 50 are smaller
+    EXPECT_EQ(bst.Rank(100), 7);
+    EXPECT_EQ(bst.Select(0), 20);
+    EXPECT_EQ(bst.Select(3), 50);
+    EXPECT_EQ(bst.Select(6), 80);
+    EXPECT_THROW(bst.Select(7), std::out_of_range);
+
+    bst.Remove(50); // Node with two children
+    EXPECT_EQ(bst.Size(), 6);
+    EXPECT_EQ(bst.Select(3), 60);
+    EXPECT_TRUE(bst.isValidBST());
+}
+
+TEST(BinaryTreeOrderStatisticTests, DuplicateKeys) {
+    BinaryTree<double, true> bst;
+    for (double value : {2.5, 1.0, 2.5, 3.0, 2.5}) {
+        bst.Add(value);
+    }
+
+    EXPECT_EQ(bst.Size(), 5);
+    EXPECT_EQ(bst.Count(2.5), 3);
+    EXPECT_EQ(bst.Rank(2.5), 1);
+    EXPECT_DOUBLE_EQ(bst.Select(1), 2.5);
+    EXPECT_DOUBLE_EQ(bst.Select(3), 2.5);
+    EXPECT_DOUBLE_EQ(bst.Select(4), 3.0);
+
+    bst.Remove(2.5); // Removes a single copy
+    EXPECT_EQ(bst.Count(2.5), 2);
+    EXPECT_EQ(bst.Size(), 4);
+    EXPECT_TRUE(bst.isValidBST());
+
+    std::ostringstream output;
+    std::streambuf* oldCoutBuffer = std::cout.rdbuf(output.rdbuf());
+    bst.InorderTraverse();
+    std::cout.rdbuf(oldCoutBuffer); // Reset cout
+
+    EXPECT_EQ(output.str(), "1 2.5 2.5 3 \n");
+}
+
+TEST(BinaryTreeOrderStatisticTests, MatchesSortedReferenceUnderChurn) {
+    BinaryTree<int, true> bst;
+    std::vector<int> reference;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> values(0, 50);
+
+    for (int step = 0; step < 2000; ++step) {
+        int value = values(gen);
+        if (step % 3 == 2 && !reference.empty()) {
+            bst.Remove(value);
+            auto it = std::find(reference.begin(), reference.end(), value);
+            if (it != reference.end()) reference.erase(it);
+        } else {
+            bst.Add(value);
+            reference.push_back(value);
+        }
+    }
+
+    std::sort(reference.begin(), reference.end());
+    ASSERT_EQ(bst.Size(), reference.size());
+    ASSERT_TRUE(bst.isValidBST());
+    for (size_t k = 0; k < reference.size(); ++k) {
+        ASSERT_EQ(bst.Select(k), reference[k]);
+    }
+    for (int value = -1; value <= 51; ++value) {
+        size_t expectedRank = std::lower_bound(reference.begin(), reference.end(), value) - reference.begin();
+        ASSERT_EQ(bst.Rank(value), expectedRank);
+    }
+}
+
+// Balanced Tree Tests
+TEST(BalancedBinaryTreeTests, SortedInsertKeepsLogarithmicHeight) {
+    BalancedBinaryTree<int> bst;
+    const int count = 100000;
+    for (int i = 0; i < count; ++i) {
+        bst.Add(i);
+    }
+
+    EXPECT_EQ(bst.Size(), static_cast<size_t>(count));
+    EXPECT_LE(bst.Height(), static_cast<int>(1.45 * std::log2(count + 2)));
+    EXPECT_TRUE(bst.isValidBST());
+    EXPECT_TRUE(bst.isBalanced());
+    EXPECT_EQ(bst.Minimum(), 0);
+    EXPECT_EQ(bst.Maximum(), count - 1);
+    EXPECT_EQ(bst.Select(12345), 12345);
+    EXPECT_EQ(bst.Rank(54321), 54321u);
+
+    // Remove from one end, the pattern of a sliding window over ordered data
+    for (int i = 0; i < count / 2; ++i) {
+        bst.Remove(i);
+    }
+    EXPECT_EQ(bst.Size(), static_cast<size_t>(count / 2));
+    EXPECT_EQ(bst.Minimum(), count / 2);
+    EXPECT_LE(bst.Height(), static_cast<int>(1.45 * std::log2(count / 2 + 2)));
+    EXPECT_TRUE(bst.isBalanced());
+}
+
+TEST(BalancedBinaryTreeTests, RemoveCases) {
+    BalancedBinaryTree<int> bst;
+    for (int value : {50, 30, 70, 20, 40, 60, 80}) {
+        bst.Add(value);
+    }
+    bst.Add(40); // Duplicates are ignored by default
+    EXPECT_EQ(bst.Size(), 7);
+    EXPECT_EQ(bst.Count(40), 1);
+
+    bst.Remove(20); // Leaf
+    bst.Remove(30); // One child
+    bst.Remove(50); // Two children
+    bst.Remove(99); // Absent
+    EXPECT_EQ(bst.Size(), 4);
+    EXPECT_FALSE(bst.Find(50));
+    EXPECT_TRUE(bst.Find(60));
+    EXPECT_EQ(bst.Select(0), 40);
+    EXPECT_EQ(bst.Select(3), 80);
+    EXPECT_TRUE(bst.isValidBST());
+    EXPECT_TRUE(bst.isBalanced());
+
+    bst.clear();
+    EXPECT_EQ(bst.Size(), 0);
+    EXPECT_EQ(bst.Height(), 0);
+    EXPECT_THROW(bst.Minimum(), std::out_of_range);
+}
+
+TEST(BalancedBinaryTreeTests, MatchesSortedReferenceUnderChurn) {
+    BalancedBinaryTree<int, true> bst;
+    std::vector<int> reference;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> values(0, 500);
+
+    for (int step = 0; step < 20000; ++step) {
+        int value = values(gen);
+        if (step % 3 == 2 && !reference.empty()) {
+            bst.Remove(value);
+            auto it = std::find(reference.begin(), reference.end(), value);
+            if (it != reference.end()) reference.erase(it);
+        } else {
+            bst.Add(value);
+            reference.push_back(value);
+        }
+        if (step % 1000 == 0) {
+            ASSERT_TRUE(bst.isValidBST());
+            ASSERT_TRUE(bst.isBalanced());
+        }
+    }
+
+    std::sort(reference.begin(), reference.end());
+    ASSERT_EQ(bst.Size(), reference.size());
+    ASSERT_TRUE(bst.isValidBST());
+    ASSERT_TRUE(bst.isBalanced());
+    for (size_t k = 0; k < reference.size(); ++k) {
+        ASSERT_EQ(bst.Select(k), reference[k]);
+    }
+    for (int value = -1; value <= 501; ++value) {
+        size_t expectedRank = std::lower_bound(reference.begin(), reference.end(), value) - reference.begin();
+        ASSERT_EQ(bst.Rank(value), expectedRank);
+        ASSERT_EQ(bst.Count(value), static_cast<size_t>(std::count(reference.begin(), reference.end(), value)));
+    }
+}
+
+// Pooled Tree Tests
+TEST(PooledBinaryTreeTests, MatchesHeapTreeUnderChurn) {
+    BinaryTree<int, true> heapTree;
+    BinaryTree<int, true, true> pooledTree;
+    BalancedBinaryTree<int, true, true> pooledBalanced;
+    std::mt19937 gen(21);
+    std::uniform_int_distribution<> values(0, 200);
+
+    for (int step = 0; step < 5000; ++step) {
+        int value = values(gen);
+        if (step % 3 == 2) {
+            heapTree.Remove(value);
+            pooledTree.Remove(value);
+            pooledBalanced.Remove(value);
+        } else {
+            heapTree.Add(value);
+            pooledTree.Add(value);
+            pooledBalanced.Add(value);
+        }
+    }
+
+    ASSERT_EQ(pooledTree.Size(), heapTree.Size());
+    ASSERT_EQ(pooledBalanced.Size(), heapTree.Size());
+    EXPECT_TRUE(pooledTree.isValidBST());
+    EXPECT_TRUE(pooledBalanced.isValidBST());
+    EXPECT_TRUE(pooledBalanced.isBalanced());
+    for (size_t k = 0; k < heapTree.Size(); ++k) {
+        ASSERT_EQ(pooledTree.Select(k), heapTree.Select(k));
+        ASSERT_EQ(pooledBalanced.Select(k), heapTree.Select(k));
+    }
+
+    // Clearing resets the pool and the tree is usable again
+    pooledTree.clear();
+    pooledBalanced.clear();
+    EXPECT_EQ(pooledTree.Size(), 0);
+    EXPECT_EQ(pooledBalanced.Size(), 0);
+    pooledTree.Add(5);
+    pooledBalanced.Add(5);
+    EXPECT_TRUE(pooledTree.Find(5));
+    EXPECT_TRUE(pooledBalanced.Find(5));
+}
+
+TEST(PooledBinaryTreeTests, NonTrivialValues) {
+    BinaryTree<std::string, false, true> bst;
+    for (const char* ticker : {"MSFT", "AAPL", "TSLA", "NVDA", "AMZN"}) {
+        bst.Add(ticker);
+    }
+    bst.Remove("TSLA");
+    EXPECT_EQ(bst.Size(), 4);
+    EXPECT_EQ(bst.Minimum(), "AAPL");
+    EXPECT_EQ(bst.Maximum(), "NVDA");
+    bst.clear();    // Destroys each string before resetting the pool
+    EXPECT_EQ(bst.Size(), 0);
+}
+
+// Iterator and Range Query Tests
+template <typename Tree>
+void checkIterationAndRanges() {
+    Tree bst;
+    std::vector<int> reference;
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<> values(0, 300);
+    for (int i = 0; i < 1500; ++i) {
+        int value = values(gen);
+        bst.Add(value);
+        reference.push_back(value);
+    }
+    std::sort(reference.begin(), reference.end());
+    ASSERT_TRUE(bst.isValidBST());
+
+    // Forward and backward iteration visit every copy in order
+    std::vector<int> forward(bst.begin(), bst.end());
+    EXPECT_EQ(forward, reference);
+    std::vector<int> backward;
+    for (auto it = bst.end(); it != bst.begin();) {
+        backward.push_back(*--it);
+    }
+    EXPECT_TRUE(std::equal(backward.rbegin(), backward.rend(), reference.begin(), reference.end()));
+
+    for (int value = -1; value <= 302; ++value) {
+        auto lower = std::lower_bound(reference.begin(), reference.end(), value);
+        auto upper = std::upper_bound(reference.begin(), reference.end(), value);
+        ASSERT_EQ(std::vector<int>(bst.lower_bound(value), bst.end()), std::vector<int>(lower, reference.end()));
+        ASSERT_EQ(std::vector<int>(bst.upper_bound(value), bst.end()), std::vector<int>(upper, reference.end()));
+    }
+
+    for (int low = -5; low <= 305; low += 13) {
+        for (int high = low - 3; high <= 310; high += 29) {
+            auto first = std::lower_bound(reference.begin(), reference.end(), low);
+            auto last = std::upper_bound(reference.begin(), reference.end(), high);
+            std::vector<int> expected = high < low ? std::vector<int>() : std::vector<int>(first, last);
+
+            std::vector<int> visited;
+            bst.RangeVisit(low, high, [&](int value) { visited.push_back(value); });
+            ASSERT_EQ(visited, expected);
+            ASSERT_EQ(bst.RangeCount(low, high), expected.size());
+        }
+    }
+}
+
+TEST(BinaryTreeIteratorTests, MatchesSortedReference) {
+    checkIterationAndRanges<BinaryTree<int, true>>();
+}
+
+TEST(BinaryTreeIteratorTests, BalancedMatchesSortedReference) {
+    checkIterationAndRanges<BalancedBinaryTree<int, true>>();
+}
+
+TEST(BinaryTreeIteratorTests, EmptyAndSingleValue) {
+    BinaryTree<int> bst;
+    EXPECT_TRUE(bst.begin() == bst.end());
+    EXPECT_TRUE(bst.lower_bound(3) == bst.end());
+    EXPECT_EQ(bst.RangeCount(0, 10), 0);
+    EXPECT_TRUE(bst.isValidBST());
+
+    bst.Add(7);
+    auto it = bst.begin();
+    EXPECT_EQ(*it, 7);
+    EXPECT_TRUE(++it == bst.end());
+    EXPECT_EQ(*--it, 7);
+    EXPECT_TRUE(bst.upper_bound(7) == bst.end());
+    EXPECT_EQ(bst.RangeCount(7, 7), 1);
+    EXPECT_EQ(bst.RangeCount(8, 6), 0);
+}
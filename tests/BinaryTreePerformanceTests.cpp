@@ -1,9 +1,11 @@
 #include <gtest/gtest.h>
 #include "../src/binary_tree/binary_tree.h"
+#include "../src/binary_tree/balanced_binary_tree.h"
 #include <chrono>
 #include <iostream>
 #include <iomanip>
 #include "test_helpers.h"
+#include <random>
 
 // Forward declare the helper function from StackQueueTests
 std::vector<int> generateRandomNumbers(size_t count);
@@ -42,4 +44,126 @@ TEST(BinaryTreePerformanceTests, AddPerformance) {
     }
 
     std::cout << "└──────────────┴──────────────┘\n";
-}
\ No newline at end of file
+}
+// Inserts 0..count-1 in ascending order, as timestamps or trending prices arrive, and returns the time taken
+template <typename Tree>
+double measureSortedAdd(size_t count) {
+    Tree bst;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        bst.Add(static_cast<int>(i));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Sorted arrival degrades the unbalanced tree to a linked list (quadratic time, linear recursion
+// depth), so it is only measured at the smaller sizes
+TEST(BinaryTreePerformanceTests, SortedAddBalancedVersusUnbalanced) {
+    std::vector<size_t> testSizes = {100, 1000, 10000, 100000};
+    const size_t unbalancedLimit = 10000;
+
+    std::cout << "┌──────────────┬──────────────┬──────────────┐\n";
+    std::cout << "│ Sorted Adds  │ Plain (ms)   │ AVL (ms)     │\n";
+    std::cout << "├──────────────┼──────────────┼──────────────┤\n";
+
+    for (size_t size : testSizes) {
+        double balanced = measureSortedAdd<BalancedBinaryTree<int>>(size);
+        std::cout << "│ " << std::setw(12) << size << " │ ";
+        if (size <= unbalancedLimit) {
+            double unbalanced = measureSortedAdd<BinaryTree<int>>(size);
+            std::cout << std::setw(12) << std::fixed << std::setprecision(4) << unbalanced;
+        } else {
+            std::cout << std::setw(12) << "skipped";
+        }
+        std::cout << " │ " << std::setw(12) << std::fixed << std::setprecision(4) << balanced << " │\n";
+    }
+
+    std::cout << "└──────────────┴──────────────┴──────────────┘\n";
+}
+
+// Builds a tree of count random values and destroys it, returning the build and teardown times
+template <typename Tree>
+std::pair<double, double> measureBuildAndDestroy(const std::vector<int>& numbers) {
+    auto* bst = new Tree;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int num : numbers) {
+        bst->Add(num);
+    }
+    auto built = std::chrono::high_resolution_clock::now();
+    delete bst;
+    auto end = std::chrono::high_resolution_clock::now();
+    return {std::chrono::duration<double, std::milli>(built - start).count(),
+            std::chrono::duration<double, std::milli>(end - built).count()};
+}
+
+// Heap-allocated nodes against nodes from the tree's own NodePool, which also turns teardown into a
+// single pool reset
+TEST(BinaryTreePerformanceTests, PooledVersusHeapNodes) {
+    std::vector<size_t> testSizes = {10000, 100000, 1000000};
+
+    std::cout << "┌──────────────┬──────────────┬──────────────┬──────────────┬──────────────┐\n";
+    std::cout << "│ Nodes        │ Heap add(ms) │ Pool add(ms) │ Heap free(ms)│ Pool free(ms)│\n";
+    std::cout << "├──────────────┼──────────────┼──────────────┼──────────────┼──────────────┤\n";
+
+    for (size_t size : testSizes) {
+        std::vector<int> numbers(size);
+        std::mt19937 gen(static_cast<unsigned>(size));
+        std::uniform_int_distribution<int> values(0, 1 << 30);
+        for (int& number : numbers) number = values(gen);
+
+        auto [heapAdd, heapFree] = measureBuildAndDestroy<BinaryTree<int>>(numbers);
+        auto [poolAdd, poolFree] = measureBuildAndDestroy<BinaryTree<int, false, true>>(numbers);
+
+        std::cout << "│ " << std::setw(12) << size << std::fixed << std::setprecision(4);
+        for (double time : {heapAdd, poolAdd, heapFree, poolFree}) {
+            std::cout << " │ " << std::setw(12) << time;
+        }
+        std::cout << " │\n";
+    }
+
+    std::cout << "└──────────────┴──────────────┴──────────────┴──────────────┴──────────────┘\n";
+}
+
+// Narrow range queries answered by RangeVisit and RangeCount against filtering a full in-order walk
+TEST(BinaryTreePerformanceTests, RangeQueryVersusFullScan) {
+    const size_t size = 1000000;
+    const int queries = 1000;
+    const int width = 1000;     // About 1000 matches per query over values in [0, 2^20)
+    BalancedBinaryTree<int, true, true> bst;
+    std::mt19937 gen(9);
+    std::uniform_int_distribution<int> values(0, (1 << 20) - 1);
+    for (size_t i = 0; i < size; ++i) bst.Add(values(gen));
+
+    std::vector<int> lows(queries);
+    for (int& low : lows) low = values(gen);
+
+    auto time = [](auto&& body) {
+        auto start = std::chrono::high_resolution_clock::now();
+        body();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    size_t visited = 0, counted = 0, scanned = 0;
+    double visitTime = time([&] {
+        for (int low : lows) bst.RangeVisit(low, low + width, [&](int) { ++visited; });
+    });
+    double countTime = time([&] {
+        for (int low : lows) counted += bst.RangeCount(low, low + width);
+    });
+    double scanTime = time([&] {
+        for (int i = 0; i < 10; ++i) {  // A full walk per query is too slow to run all of them
+            for (int value : bst) {
+                if (value >= lows[i] && value <= lows[i] + width) ++scanned;
+            }
+        }
+    }) * (queries / 10);
+
+    EXPECT_EQ(visited, counted);
+    std::cout << "\n" << queries << " range queries over " << size << " values (ms):\n"
+              << std::fixed << std::setprecision(4)
+              << "  RangeVisit          " << std::setw(12) << visitTime << "\n"
+              << "  RangeCount          " << std::setw(12) << countTime << "\n"
+              << "  Full scan (approx.) " << std::setw(12) << scanTime << "\n";
+}
@@ -1,8 +1,51 @@
 #include <gtest/gtest.h>
 #include <unordered_map>
+#include <random>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <cmath>
 #include "test_helpers.h"
 #include "../src/hash_tables/hash_table.h" // Phase 1 Hash Table
 #include "../src/hash_tables/open_addressing_hash_table.h" // Phase 2 Hash Table
+#include "../src/hash_tables/robin_hood_hash_table.h"
+#include "../src/hash_tables/concurrent_hash_map.h"
+#include "../src/core/symbol_table.h"
+
+// Bytes currently allocated through CountingAllocator, for measuring what a container holds
+static size_t countedBytes = 0;
+
+// std::allocator that adds what it hands out to countedBytes; single-threaded use only
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        countedBytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* pointer, size_t n) {
+        countedBytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(pointer, n);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T>&, const CountingAllocator<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T>&, const CountingAllocator<U>&) { return false; }
+
+// std::unordered_map whose nodes and buckets are counted, as the baseline for the tables' getMemoryUsage()
+template <typename Key>
+using CountedUnorderedMap = std::unordered_map<Key, int, std::hash<Key>, std::equal_to<Key>,
+                                               CountingAllocator<std::pair<const Key, int>>>;
 
 // Test Phase 1: Chaining
 TEST(HashTablePerformanceTests, Phase1ChainingPerformance) {
@@ -39,3 +82,705 @@ TEST(HashTablePerformanceTests, BuiltInHashTablePerformance) {
     printHashTablePerformanceTable(insertTimes, retrieveTimes, removeTimes, "Built-in Hash Table");
 }
 
+
+// Random inserts, updates and removals over a small key range, so deleted slots, reused nodes
+// and same-capacity rehashes are exercised, checked against std::unordered_map after every operation
+template <typename Table>
+static void checkMatchesUnorderedMapUnderChurn(unsigned seed) {
+    Table hashTable;
+    std::unordered_map<int, int> reference;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> key(0, 5000);
+    std::uniform_int_distribution<int> operation(0, 2);
+
+    for (int i = 0; i < 200000; ++i) {
+        int k = key(gen);
+        switch (operation(gen)) {
+            case 0:
+                hashTable.insert(k, i);
+                reference[k] = i;
+                break;
+            case 1:
+                ASSERT_EQ(hashTable.remove(k), reference.erase(k) == 1) << "key " << k;
+                break;
+            default: {
+                auto found = hashTable.retrieve(k);
+                auto expected = reference.find(k);
+                ASSERT_EQ(found.has_value(), expected != reference.end()) << "key " << k;
+                if (found) {
+                    ASSERT_EQ(*found, expected->second);
+                }
+            }
+        }
+        ASSERT_EQ(hashTable.getSize(), reference.size());
+    }
+
+    // Capacity stays a power of two and the table never fills up completely
+    size_t capacity = hashTable.getCapacity();
+    EXPECT_EQ(capacity & (capacity - 1), 0u);
+    EXPECT_LT(hashTable.getSize(), capacity);
+
+    Table copy = hashTable;
+    for (const auto& [k, v] : reference) {
+        ASSERT_EQ(copy.retrieve(k), std::optional<int>(v));
+    }
+}
+
+TEST(HashTablePerformanceTests, OpenAddressingMatchesUnorderedMapUnderChurn) {
+    checkMatchesUnorderedMapUnderChurn<OpenAddressingHashTable<int, int>>(38);
+}
+
+// Nanoseconds per operation for n inserts, n successful lookups, n failed lookups and n removals
+template <typename Insert, typename Lookup, typename Remove>
+static std::vector<double> timeHashTableOperations(size_t n, Insert insert, Lookup lookup, Remove remove) {
+    std::vector<double> times;
+    auto timeLoop = [&](auto&& body) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < n; ++i) body(i);
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::nano>(end - start).count() / n);
+    };
+
+    // Keys are scattered by a multiplicative constant; misses use keys that are never inserted
+    size_t found = 0;
+    timeLoop([&](size_t i) { insert(static_cast<int>(i * 2654435761u % 1000000007u)); });
+    timeLoop([&](size_t i) { found += lookup(static_cast<int>(i * 2654435761u % 1000000007u)); });
+    timeLoop([&](size_t i) { found += lookup(-1 - static_cast<int>(i)); });
+    timeLoop([&](size_t i) { remove(static_cast<int>(i * 2654435761u % 1000000007u)); });
+    EXPECT_EQ(found, n);
+    return times;
+}
+
+// Prints nanoseconds per operation for Table and std::unordered_map, one row each per size
+template <typename Table>
+static void compareWithUnorderedMap(const std::string& label) {
+    std::cout << std::setw(10) << "Size" << " | " << std::setw(22) << "Structure" << " | " << std::setw(8) << "Insert"
+              << " | " << std::setw(8) << "Hit" << " | " << std::setw(8) << "Miss" << " | " << std::setw(8) << "Remove\n";
+
+    for (size_t n : {10000, 100000, 1000000}) {
+        Table table;
+        std::vector<double> custom = timeHashTableOperations(n,
+            [&](int k) { table.insert(k, k); },
+            [&](int k) { return table.retrieve(k).has_value(); },
+            [&](int k) { table.remove(k); });
+
+        std::unordered_map<int, int> builtIn;
+        std::vector<double> stl = timeHashTableOperations(n,
+            [&](int k) { builtIn[k] = k; },
+            [&](int k) { return builtIn.find(k) != builtIn.end(); },
+            [&](int k) { builtIn.erase(k); });
+
+        for (const auto& [name, times] : {std::make_pair(label, custom),
+                                          std::make_pair(std::string("std::unordered_map"), stl)}) {
+            std::cout << std::setw(10) << n << " | " << std::setw(22) << name << std::fixed << std::setprecision(1);
+            for (double time : times) std::cout << " | " << std::setw(8) << time;
+            std::cout << "\n";
+        }
+    }
+}
+
+TEST(HashTablePerformanceTests, OpenAddressingVersusUnorderedMap) {
+    std::cout << "\nSwiss-table OpenAddressingHashTable vs std::unordered_map (ns per operation):\n";
+    compareWithUnorderedMap<OpenAddressingHashTable<int, int>>("OpenAddressingHashTable");
+}
+
+TEST(HashTablePerformanceTests, ChainingMatchesUnorderedMapUnderChurn) {
+    checkMatchesUnorderedMapUnderChurn<HashTable<int, int>>(41);
+}
+
+// Removing a key releases what its key and value own instead of keeping it until the node is reused
+TEST(HashTablePerformanceTests, ChainingRemoveReleasesValues) {
+    using CountedSeries = std::vector<double, CountingAllocator<double>>;
+    HashTable<std::string, CountedSeries> series;
+    size_t before = countedBytes;
+    for (int i = 0; i < 100; ++i) {
+        series.insert("TICKER_WITH_A_LONG_NAME_" + std::to_string(i), CountedSeries(1000, 1.0));
+    }
+    EXPECT_EQ(countedBytes - before, 100 * 1000 * sizeof(double));
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(series.remove("TICKER_WITH_A_LONG_NAME_" + std::to_string(i)));
+    }
+    EXPECT_EQ(countedBytes, before) << "Removed values should free their prices.";
+    series.insert("AAPL", CountedSeries(3, 2.0));
+    EXPECT_EQ(series.retrieve("AAPL"), std::optional<CountedSeries>(CountedSeries(3, 2.0)));
+}
+
+TEST(HashTablePerformanceTests, ChainingStringViewLookup) {
+    StringHashTable<double> closes;
+    closes.insert("AAPL", 189.5);
+    closes.insert("MSFT", 415.25);
+
+    // Probed by std::string_view, const char* and std::string without building a temporary key
+    std::string_view line = "AAPL,MSFT,TSLA";
+    EXPECT_EQ(closes.retrieve(line.substr(0, 4)), std::optional<double>(189.5));
+    EXPECT_EQ(closes.retrieve("MSFT"), std::optional<double>(415.25));
+    EXPECT_FALSE(closes.retrieve(line.substr(10, 4)).has_value());
+    EXPECT_EQ(closes.retrieve(std::string("AAPL")), std::optional<double>(189.5));
+
+    EXPECT_TRUE(closes.remove(line.substr(5, 4)));
+    EXPECT_FALSE(closes.retrieve("MSFT").has_value());
+    EXPECT_EQ(closes.getSize(), 1u);
+
+    // A removed node is reused by the next insert
+    closes.insert("TSLA", 242.0);
+    EXPECT_EQ(closes.retrieve("TSLA"), std::optional<double>(242.0));
+    EXPECT_EQ(closes.getSize(), 2u);
+}
+
+TEST(HashTablePerformanceTests, ChainingVersusUnorderedMap) {
+    std::cout << "\nPooled-node chaining HashTable vs std::unordered_map (ns per operation):\n";
+    compareWithUnorderedMap<HashTable<int, int>>("HashTable");
+}
+
+TEST(HashTablePerformanceTests, RobinHoodMatchesUnorderedMapUnderChurn) {
+    checkMatchesUnorderedMapUnderChurn<RobinHoodHashTable<int, int>>(39);
+}
+
+// Key whose hash the test chooses, to pile many keys onto one home slot
+struct CollidingKey {
+    int id;
+    size_t hashValue;
+    bool operator==(const CollidingKey& other) const { return id == other.id; }
+};
+
+template <>
+struct std::hash<CollidingKey> {
+    size_t operator()(const CollidingKey& key) const { return key.hashValue; }
+};
+
+TEST(HashTablePerformanceTests, RobinHoodRefusesKeysNoCapacityCanSeparate) {
+    auto key = [](int id) { return CollidingKey{id, 42}; };
+
+    // Identical hashes share one home slot, so at most MAX_DISTANCE (254) of them can be placed;
+    // later ones are refused without changing the table
+    RobinHoodHashTable<CollidingKey, int> table;
+    for (int i = 0; i < 300; ++i) {
+        if (i < 254) {
+            table.insert(key(i), i);
+        } else {
+            EXPECT_THROW(table.insert(key(i), i), std::length_error);
+        }
+    }
+    EXPECT_EQ(table.getSize(), 254u);
+    table.insert(key(10), -10);     // Updating a stored key is still allowed
+    EXPECT_EQ(table.retrieve(key(10)), std::optional<int>(-10));
+
+    for (int i = 0; i < 254; i += 3) {
+        EXPECT_TRUE(table.remove(key(i)));
+    }
+    EXPECT_EQ(table.getSize(), 169u);
+    for (int i = 0; i < 300; ++i) {
+        EXPECT_EQ(table.retrieve(key(i)).has_value(), i < 254 && i % 3 != 0) << "key " << i;
+    }
+    for (int i = 300; i < 385; ++i) {
+        table.insert(key(i), i);
+    }
+    EXPECT_THROW(table.insert(key(385), 385), std::length_error);
+    EXPECT_LE(table.getProbeStatistics().maxProbeLength, 254u);
+
+    // Two groups of 200 whose clusters can overlap; growing separates them
+    RobinHoodHashTable<CollidingKey, int> twoHashes;
+    for (int i = 0; i < 400; ++i) {
+        twoHashes.insert(CollidingKey{i, static_cast<size_t>(i % 2)}, i);
+    }
+    for (int i = 0; i < 400; i += 3) {
+        EXPECT_TRUE(twoHashes.remove(CollidingKey{i, static_cast<size_t>(i % 2)}));
+    }
+    EXPECT_EQ(twoHashes.getSize(), 266u);
+    for (int i = 0; i < 400; ++i) {
+        EXPECT_EQ(twoHashes.retrieve(CollidingKey{i, static_cast<size_t>(i % 2)}).has_value(), i % 3 != 0) << "key " << i;
+    }
+}
+
+// A symbol cache that keeps about 50k tickers while rotating through millions over the day:
+// each step evicts the oldest symbol and admits a new one, so without tombstone cleanup the
+// probe lengths would keep growing
+TEST(HashTablePerformanceTests, RobinHoodProbeLengthsStayBoundedUnderRotation) {
+    const size_t live = 50000;
+    const size_t rotations = 2000000;
+    auto symbol = [](size_t i) { return "SYM" + std::to_string(i); };
+
+    RobinHoodHashTable<std::string, size_t> robinHood;
+    OpenAddressingHashTable<std::string, size_t> swiss;
+    std::unordered_map<std::string, size_t> builtIn;
+    for (size_t i = 0; i < live; ++i) {
+        robinHood.insert(symbol(i), i);
+        swiss.insert(symbol(i), i);
+        builtIn[symbol(i)] = i;
+    }
+    size_t capacityBefore = robinHood.getCapacity();
+
+    std::vector<std::string> added(rotations), evicted(rotations);
+    for (size_t i = 0; i < rotations; ++i) {
+        added[i] = symbol(live + i);
+        evicted[i] = symbol(i);
+    }
+
+    auto timeRotation = [&](auto&& rotate) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rotations; ++i) rotate(i);
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / rotations;
+    };
+
+    double robinHoodTime = timeRotation([&](size_t i) {
+        robinHood.remove(evicted[i]);
+        robinHood.insert(added[i], i);
+        robinHood.retrieve(added[i / 2 + live / 2]);
+    });
+    double swissTime = timeRotation([&](size_t i) {
+        swiss.remove(evicted[i]);
+        swiss.insert(added[i], i);
+        swiss.retrieve(added[i / 2 + live / 2]);
+    });
+    double builtInTime = timeRotation([&](size_t i) {
+        builtIn.erase(evicted[i]);
+        builtIn[added[i]] = i;
+        builtIn.find(added[i / 2 + live / 2]);
+    });
+
+    auto statistics = robinHood.getProbeStatistics();
+    std::cout << "\nSymbol cache rotation (" << live << " live, " << rotations << " rotations), ns per rotation:\n"
+              << "  RobinHoodHashTable:      " << std::fixed << std::setprecision(1) << robinHoodTime
+              << "  (max probe " << statistics.maxProbeLength << ", mean probe "
+              << std::setprecision(2) << statistics.averageProbeLength << ")\n"
+              << "  OpenAddressingHashTable: " << std::setprecision(1) << swissTime << "\n"
+              << "  std::unordered_map:      " << builtInTime << "\n";
+
+    EXPECT_EQ(robinHood.getSize(), live);
+    EXPECT_EQ(robinHood.getCapacity(), capacityBefore) << "Rotation alone must not grow the table.";
+    EXPECT_LT(statistics.maxProbeLength, 64u);
+    EXPECT_LT(statistics.averageProbeLength, 4.0);
+    for (size_t i = rotations; i < rotations + live; ++i) {
+        ASSERT_EQ(robinHood.retrieve(symbol(i)), std::optional<size_t>(i - live)) << symbol(i);
+    }
+}
+
+TEST(HashTablePerformanceTests, ConcurrentHashMapKeepsEveryWrite) {
+    // Small initial capacity so every segment rehashes several times while the threads run
+    ConcurrentHashMap<std::string, int> map(16, 8);
+    const int threads = 4;
+    const int perThread = 20000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&map, t]() {
+            for (int i = 0; i < perThread; ++i) {
+                map.insert("T" + std::to_string(t) + "_" + std::to_string(i), i);
+                // Read back a key another thread may be writing at the same time
+                map.retrieve("T" + std::to_string((t + 1) % threads) + "_" + std::to_string(i));
+                if (i % 2 == 1) {
+                    EXPECT_TRUE(map.remove("T" + std::to_string(t) + "_" + std::to_string(i - 1)));
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(map.getSize(), static_cast<size_t>(threads * perThread / 2));
+    for (int t = 0; t < threads; ++t) {
+        for (int i = 0; i < perThread; ++i) {
+            auto found = map.retrieve("T" + std::to_string(t) + "_" + std::to_string(i));
+            if (i % 2 == 1) {
+                ASSERT_EQ(found, std::optional<int>(i));
+            } else {
+                ASSERT_FALSE(found.has_value());
+            }
+        }
+    }
+
+    // Series are cached by ticker SymbolId, so a lookup hashes one integer instead of a name
+    const StockScanner::SymbolId aapl = 0, msft = 1;
+    std::vector<double> series{1.0, 2.0, 3.0};
+    ConcurrentHashMap<StockScanner::SymbolId, std::vector<double>> seriesCache;
+    seriesCache.insert(aapl, series);
+    double sum = 0.0;
+    EXPECT_TRUE(seriesCache.visit(aapl, [&sum](const std::vector<double>& prices) {
+        for (double price : prices) sum += price;
+    }));
+    EXPECT_DOUBLE_EQ(sum, 6.0);
+    EXPECT_FALSE(seriesCache.visit(msft, [](const std::vector<double>&) {}));
+    EXPECT_THROW((ConcurrentHashMap<int, int>(16, 0)), std::invalid_argument);
+}
+
+// Baseline for the concurrency benchmark: one reader-writer lock around the whole map
+template <typename KeyType, typename ValueType>
+class GloballyLockedMap {
+private:
+    mutable std::shared_mutex mutex;
+    std::unordered_map<KeyType, ValueType> map;
+
+public:
+    void insert(const KeyType& key, const ValueType& value) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        map[key] = value;
+    }
+
+    std::optional<ValueType> retrieve(const KeyType& key) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = map.find(key);
+        if (it == map.end()) return std::nullopt;
+        return it->second;
+    }
+
+    bool remove(const KeyType& key) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        return map.erase(key) == 1;
+    }
+};
+
+// Runs opsPerThread operations on each of `threads` threads against a map pre-filled with
+// keys[0, keys.size() / 2); readPercent of them are lookups and the rest split evenly between
+// inserts and removes. Returns millions of operations per second.
+template <typename Map>
+static double measureConcurrentThroughput(Map& map, const std::vector<std::string>& keys,
+                                          size_t threads, size_t opsPerThread, int readPercent) {
+    for (size_t i = 0; i < keys.size() / 2; ++i) {
+        map.insert(keys[i], static_cast<int>(i));
+    }
+
+    auto work = [&](size_t thread) {
+        std::mt19937 gen(static_cast<unsigned>(thread) + 1);
+        std::uniform_int_distribution<size_t> key(0, keys.size() - 1);
+        std::uniform_int_distribution<int> operation(0, 99);
+        for (size_t i = 0; i < opsPerThread; ++i) {
+            const std::string& k = keys[key(gen)];
+            int op = operation(gen);
+            if (op < readPercent) {
+                map.retrieve(k);
+            } else if (op % 2 == 0) {
+                map.insert(k, op);
+            } else {
+                map.remove(k);
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back(work, t);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(threads * opsPerThread) / seconds / 1e6;
+}
+
+TEST(HashTablePerformanceTests, ConcurrentHashMapThroughputScaling) {
+    const size_t keyCount = 100000;
+    const size_t opsPerThread = 200000;
+    std::vector<std::string> keys(keyCount);
+    for (size_t i = 0; i < keyCount; ++i) {
+        keys[i] = "SYM" + std::to_string(i);
+    }
+
+    size_t hardwareThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    std::cout << "\nConcurrent map throughput, Mops/s (" << hardwareThreads << " hardware threads):\n";
+    std::cout << std::left << std::setw(12) << "Workload" << std::setw(10) << "Threads"
+              << std::setw(20) << "ConcurrentHashMap" << "Globally locked unordered_map\n";
+
+    for (auto [workload, readPercent] : {std::pair<const char*, int>{"read-heavy", 95}, {"mixed", 50}}) {
+        for (size_t threads = 1; threads <= std::max<size_t>(8, hardwareThreads); threads *= 2) {
+            ConcurrentHashMap<std::string, int> segmented;
+            GloballyLockedMap<std::string, int> globallyLocked;
+            double segmentedRate = measureConcurrentThroughput(segmented, keys, threads, opsPerThread, readPercent);
+            double lockedRate = measureConcurrentThroughput(globallyLocked, keys, threads, opsPerThread, readPercent);
+
+            std::cout << std::left << std::setw(12) << workload << std::setw(10) << threads
+                      << std::setw(20) << std::fixed << std::setprecision(2) << segmentedRate << lockedRate << "\n";
+            EXPECT_GT(segmentedRate, 0.0);
+        }
+    }
+}
+
+// Benchmark suite: every table against std::unordered_map on int and ticker-string keys, with
+// hit-heavy and miss-heavy lookups, erase/insert churn, a load factor sweep and bytes per element.
+// Each measurement is repeated and reported as the median and p95 over the trials. Sizes run up
+// to HASH_BENCH_MAX_SIZE (default 100000, up to 10000000) so the default test run stays short.
+static size_t benchmarkMaxSize() {
+    const char* configured = std::getenv("HASH_BENCH_MAX_SIZE");
+    if (configured == nullptr) return 100000;
+    try {
+        return std::stoul(configured);
+    } catch (const std::exception&) {
+        std::cerr << "Ignoring invalid HASH_BENCH_MAX_SIZE=" << configured << "\n";
+        return 100000;
+    }
+}
+
+static const size_t BENCHMARK_TRIALS = 5;
+
+// Value at the given percentile (0-100) of the samples using the nearest-rank method
+static double percentileOf(std::vector<double> samples, double percentile) {
+    std::sort(samples.begin(), samples.end());
+    size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * samples.size()));
+    return samples[rank == 0 ? 0 : rank - 1];
+}
+
+// Uniform operations over the repo's tables and std::unordered_map
+template <typename Table, typename Key>
+static void insertKey(Table& table, const Key& key, int value) { table.insert(key, value); }
+
+template <typename Key>
+static void insertKey(CountedUnorderedMap<Key>& table, const Key& key, int value) { table[key] = value; }
+
+template <typename Table, typename Key>
+static bool containsKey(const Table& table, const Key& key) { return table.retrieve(key).has_value(); }
+
+template <typename Key>
+static bool containsKey(const CountedUnorderedMap<Key>& table, const Key& key) { return table.find(key) != table.end(); }
+
+template <typename Table, typename Key>
+static void removeKey(Table& table, const Key& key) { table.remove(key); }
+
+template <typename Key>
+static void removeKey(CountedUnorderedMap<Key>& table, const Key& key) { table.erase(key); }
+
+// Bytes held by a table's own storage, excluding what the keys own
+template <typename Table>
+static size_t footprintBytes(const Table& table, size_t) { return table.getMemoryUsage(); }
+
+template <typename Key>
+static size_t footprintBytes(const CountedUnorderedMap<Key>&, size_t countedBefore) { return countedBytes - countedBefore; }
+
+// Keys 0..count-1 rendered as the key type; string keys look like tickers with an exchange suffix
+template <typename Key>
+static std::vector<Key> benchmarkKeys(size_t count);
+
+template <>
+std::vector<int> benchmarkKeys<int>(size_t count) {
+    std::vector<int> keys(count);
+    for (size_t i = 0; i < count; ++i) keys[i] = static_cast<int>(i * 2654435761u % 2147483647u);
+    return keys;
+}
+
+template <>
+std::vector<std::string> benchmarkKeys<std::string>(size_t count) {
+    std::vector<std::string> keys(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string ticker;
+        for (size_t rest = i; ticker.empty() || rest > 0; rest /= 26) {
+            ticker += static_cast<char>('A' + rest % 26);
+        }
+        keys[i] = ticker + ".US";
+    }
+    return keys;
+}
+
+struct BenchmarkSummary {
+    double insertMedian, insertP95;
+    double hitMedian, hitP95;
+    double missMedian, missP95;
+    double churnMedian, churnP95;
+    double bytesPerElement;
+};
+
+// Builds a fresh table from keys[0, n) each trial and times, in ns per operation: the inserts,
+// n lookups of present keys in random order, n lookups of absent keys, and n churn steps that
+// each erase a present key and insert an absent one. keys must hold 2n keys.
+template <typename Key, typename MakeTable>
+static BenchmarkSummary runHashTableBenchmark(const std::vector<Key>& keys, size_t n, MakeTable makeTable) {
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(43));
+
+    std::vector<double> inserts, hits, misses, churns;
+    double bytesPerElement = 0.0;
+    size_t found = 0;
+    auto nsPerOperation = [n](auto start, auto end) {
+        return std::chrono::duration<double, std::nano>(end - start).count() / n;
+    };
+
+    for (size_t trial = 0; trial < BENCHMARK_TRIALS; ++trial) {
+        size_t countedBefore = countedBytes;
+        auto table = makeTable();
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < n; ++i) insertKey(table, keys[i], static_cast<int>(i));
+        auto end = std::chrono::steady_clock::now();
+        inserts.push_back(nsPerOperation(start, end));
+        bytesPerElement = static_cast<double>(footprintBytes(table, countedBefore)) / n;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i : order) found += containsKey(table, keys[i]);
+        end = std::chrono::steady_clock::now();
+        hits.push_back(nsPerOperation(start, end));
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = n; i < 2 * n; ++i) found += containsKey(table, keys[i]);
+        end = std::chrono::steady_clock::now();
+        misses.push_back(nsPerOperation(start, end));
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            removeKey(table, keys[order[i]]);
+            insertKey(table, keys[n + i], static_cast<int>(i));
+        }
+        end = std::chrono::steady_clock::now();
+        churns.push_back(nsPerOperation(start, end));
+    }
+    EXPECT_EQ(found, BENCHMARK_TRIALS * n) << "Every hit lookup and no miss lookup should find its key.";
+
+    return {percentileOf(inserts, 50), percentileOf(inserts, 95), percentileOf(hits, 50), percentileOf(hits, 95),
+            percentileOf(misses, 50), percentileOf(misses, 95), percentileOf(churns, 50), percentileOf(churns, 95),
+            bytesPerElement};
+}
+
+static void printBenchmarkHeader(const std::string& title, const std::string& firstColumn) {
+    std::cout << "\n" << title << " (ns per operation, median / p95 of " << BENCHMARK_TRIALS << " trials):\n";
+    std::cout << std::left << std::setw(10) << firstColumn << std::setw(26) << "Structure" << std::right
+              << std::setw(17) << "Insert" << std::setw(17) << "Hit" << std::setw(17) << "Miss"
+              << std::setw(17) << "Churn" << std::setw(12) << "Bytes/elem" << "\n";
+}
+
+static void printBenchmarkRow(const std::string& firstColumn, const std::string& label, const BenchmarkSummary& summary) {
+    auto cell = [](double median, double p95) {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(1) << median << " / " << p95;
+        return text.str();
+    };
+    std::cout << std::left << std::setw(10) << firstColumn << std::setw(26) << label << std::right
+              << std::setw(17) << cell(summary.insertMedian, summary.insertP95)
+              << std::setw(17) << cell(summary.hitMedian, summary.hitP95)
+              << std::setw(17) << cell(summary.missMedian, summary.missP95)
+              << std::setw(17) << cell(summary.churnMedian, summary.churnP95)
+              << std::setw(12) << std::fixed << std::setprecision(1) << summary.bytesPerElement << "\n";
+}
+
+template <typename Key>
+static void runSizeSweep(const std::string& keyName) {
+    const size_t maxSize = std::min<size_t>(benchmarkMaxSize(), 10000000);
+    std::vector<Key> keys = benchmarkKeys<Key>(2 * maxSize);
+
+    printBenchmarkHeader(keyName + " keys by table size", "Size");
+    for (size_t n : {1000, 10000, 100000, 1000000, 10000000}) {
+        if (n > maxSize) break;
+        printBenchmarkRow(std::to_string(n), "HashTable",
+                          runHashTableBenchmark(keys, n, [] { return HashTable<Key, int>(); }));
+        printBenchmarkRow(std::to_string(n), "OpenAddressingHashTable",
+                          runHashTableBenchmark(keys, n, [] { return OpenAddressingHashTable<Key, int>(); }));
+        printBenchmarkRow(std::to_string(n), "std::unordered_map",
+                          runHashTableBenchmark(keys, n, [] { return CountedUnorderedMap<Key>(); }));
+    }
+}
+
+TEST(HashTableBenchmarkSuite, IntKeysBySize) {
+    runSizeSweep<int>("int");
+}
+
+TEST(HashTableBenchmarkSuite, TickerKeysBySize) {
+    runSizeSweep<std::string>("Ticker string");
+}
+
+TEST(HashTableBenchmarkSuite, TickerKeysByLoadFactor) {
+    const size_t n = std::min<size_t>(benchmarkMaxSize(), 100000);
+    std::vector<std::string> keys = benchmarkKeys<std::string>(2 * n);
+
+    printBenchmarkHeader("Ticker string keys by load factor at " + std::to_string(n) + " keys", "Load");
+    for (float loadFactor : {0.5f, 0.7f, 0.85f, 0.95f}) {
+        std::ostringstream load;
+        load << std::fixed << std::setprecision(2) << loadFactor;
+        printBenchmarkRow(load.str(), "HashTable",
+                          runHashTableBenchmark(keys, n, [=] { return HashTable<std::string, int>(16, loadFactor); }));
+        printBenchmarkRow(load.str(), "OpenAddressingHashTable",
+                          runHashTableBenchmark(keys, n, [=] { return OpenAddressingHashTable<std::string, int>(16, loadFactor); }));
+        printBenchmarkRow(load.str(), "std::unordered_map", runHashTableBenchmark(keys, n, [=] {
+            CountedUnorderedMap<std::string> table;
+            table.max_load_factor(loadFactor);
+            return table;
+        }));
+    }
+}
+
+// Checks reserve, insertRange and forEach on one table type: a reserved table takes count inserts
+// without growing, a bulk build holds every pair, and iteration visits each live element once
+template <typename Table>
+static void checkBulkLoad() {
+    const size_t count = 50000;
+    std::vector<std::pair<int, int>> pairs(count);
+    for (size_t i = 0; i < count; ++i) pairs[i] = {static_cast<int>(i * 7919), static_cast<int>(i)};
+
+    Table reserved;
+    reserved.reserve(count);
+    size_t capacity = reserved.getCapacity();
+    for (const auto& [key, value] : pairs) reserved.insert(key, value);
+    EXPECT_EQ(reserved.getCapacity(), capacity) << "Inserting the reserved count must not grow the table.";
+
+    Table bulk;
+    bulk.insertRange(pairs.begin(), pairs.end());
+    ASSERT_EQ(bulk.getSize(), count);
+    for (size_t i = 0; i < count; i += 97) {
+        ASSERT_EQ(bulk.retrieve(pairs[i].first), std::optional<int>(pairs[i].second));
+    }
+
+    for (size_t i = 0; i < count; i += 2) bulk.remove(pairs[i].first);
+    size_t visited = 0;
+    long long valueSum = 0;
+    bulk.forEach([&](const int& key, const int& value) {
+        ++visited;
+        valueSum += value;
+        EXPECT_EQ(key, value * 7919);
+    });
+    EXPECT_EQ(visited, count / 2);
+    EXPECT_EQ(valueSum, static_cast<long long>(count / 2) * (count / 2)); // Sum of the odd values below count
+}
+
+TEST(HashTablePerformanceTests, BulkLoadReserveAndIteration) {
+    checkBulkLoad<HashTable<int, int>>();
+    checkBulkLoad<OpenAddressingHashTable<int, int>>();
+    checkBulkLoad<RobinHoodHashTable<int, int>>();
+}
+
+TEST(HashTableBenchmarkSuite, BulkLoadVersusIncrementalInsert) {
+    const size_t n = std::min<size_t>(benchmarkMaxSize(), 10000000);
+    std::vector<std::string> keys = benchmarkKeys<std::string>(n);
+    std::vector<std::pair<std::string, int>> pairs(n);
+    for (size_t i = 0; i < n; ++i) pairs[i] = {keys[i], static_cast<int>(i)};
+
+    // Milliseconds for the median of the trials
+    auto timeBuild = [](auto&& build) {
+        std::vector<double> times;
+        for (size_t trial = 0; trial < BENCHMARK_TRIALS; ++trial) {
+            auto start = std::chrono::steady_clock::now();
+            build();
+            auto end = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return percentileOf(times, 50);
+    };
+
+    std::cout << "\nBuilding a table of " << n << " ticker keys (ms, median of " << BENCHMARK_TRIALS << " trials):\n";
+    std::cout << std::left << std::setw(26) << "Structure" << std::right << std::setw(14) << "insert loop"
+              << std::setw(14) << "insertRange" << std::setw(14) << "forEach" << "\n";
+
+    auto report = [&](const std::string& label, auto makeTable) {
+        double incremental = timeBuild([&] {
+            auto table = makeTable();
+            for (const auto& [key, value] : pairs) table.insert(key, value);
+        });
+        double bulk = timeBuild([&] {
+            auto table = makeTable();
+            table.insertRange(pairs.begin(), pairs.end());
+        });
+
+        auto table = makeTable();
+        table.insertRange(pairs.begin(), pairs.end());
+        long long sum = 0;
+        double iterate = timeBuild([&] {
+            table.forEach([&sum](const std::string&, const int& value) { sum += value; });
+        });
+        EXPECT_EQ(sum, static_cast<long long>(BENCHMARK_TRIALS) * n * (n - 1) / 2);
+
+        std::cout << std::left << std::setw(26) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << incremental << std::setw(14) << bulk << std::setw(14) << iterate << "\n";
+    };
+    report("HashTable", [] { return HashTable<std::string, int>(); });
+    report("OpenAddressingHashTable", [] { return OpenAddressingHashTable<std::string, int>(); });
+    report("RobinHoodHashTable", [] { return RobinHoodHashTable<std::string, int>(); });
+}
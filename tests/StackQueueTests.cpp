@@ -1,11 +1,24 @@
 #include <gtest/gtest.h>
 #include "../src/linked_lists/stack_queue.h"
+#include "../src/memory/node_pool.h"
+#include "../src/ring_buffers/spsc_queue.h"
+#include "../src/ring_buffers/mpmc_queue.h"
+#include "../src/ring_buffers/ring_buffer.h"
 #include "test_helpers.h" 
 #include <vector>
 #include <iostream>
 #include <iomanip>
 #include <stack>
 #include <queue>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <numeric>
+#include <deque>
+#include <chrono>
+#include <cmath>
 
 // Test suite for Stack
 TEST(StackTests, BasicOperations) {
@@ -63,6 +76,71 @@ TEST(QueueTests, BasicOperations) {
     EXPECT_THROW(queue.Remove(), std::out_of_range);
 }
 
+// Test suite for NodePool
+TEST(NodePoolTests, ReusesFreedSlotsAndResets) {
+    NodePool<Node> pool(4);
+    Node* first = pool.allocate(1);
+    Node* second = pool.allocate(2);
+    EXPECT_EQ(pool.getLiveCount(), 2);
+    EXPECT_EQ(pool.getCapacity(), 4);
+
+    pool.deallocate(first);
+    Node* reused = pool.allocate(3);
+    EXPECT_EQ(reused, first);   // The freed slot is handed out again
+    EXPECT_EQ(reused->data, 3);
+    EXPECT_EQ(second->data, 2);
+
+    for (int i = 0; i < 10; ++i) pool.allocate(i);
+    EXPECT_EQ(pool.getLiveCount(), 12);
+    EXPECT_EQ(pool.getCapacity(), 12);
+
+    pool.reset();   // Every node discarded, blocks kept
+    EXPECT_EQ(pool.getLiveCount(), 0);
+    EXPECT_EQ(pool.getCapacity(), 12);
+    for (int i = 0; i < 12; ++i) pool.allocate(i);
+    EXPECT_EQ(pool.getCapacity(), 12);
+
+    pool.release();
+    EXPECT_EQ(pool.getCapacity(), 0);
+    EXPECT_THROW(NodePool<Node>(0), std::invalid_argument);
+}
+
+TEST(NodePoolTests, StackAndQueueShareAPool) {
+    NodePool<Node> pool;
+    {
+        Stack stack(&pool);
+        Queue queue(&pool);
+        for (int i = 0; i < 100; ++i) {
+            stack.Insert(i);
+            queue.Insert(i);
+        }
+        EXPECT_EQ(pool.getLiveCount(), 200);
+        EXPECT_EQ(stack.Remove(), 99);
+        EXPECT_EQ(queue.Remove(), 0);
+        EXPECT_EQ(pool.getLiveCount(), 198);
+    }
+    EXPECT_EQ(pool.getLiveCount(), 0);  // Destructors return their nodes to the pool
+}
+
+// Stack and Queue drawing nodes from their own pool, default-constructible for measurePerformance
+class PooledStack {
+    NodePool<Node> pool;
+    Stack stack{&pool};
+
+public:
+    void Insert(int value) { stack.Insert(value); }
+    int Remove() { return stack.Remove(); }
+};
+
+class PooledQueue {
+    NodePool<Node> pool;
+    Queue queue{&pool};
+
+public:
+    void Insert(int value) { queue.Insert(value); }
+    int Remove() { return queue.Remove(); }
+};
+
 // Test Suite for Performance Tests
 TEST(PerformanceTests, StackAndQueuePerformance) {
     auto data = generateRandomNumbers(10000);
@@ -95,4 +173,423 @@ TEST(PerformanceTests, StackAndQueuePerformanceWithSTL) {
     // Print results
     std::cout << "\nSTL Performance (ms):\n";
     printPerformanceTable(stlStackInsertTimes, stlStackDeleteTimes, stlQueueInsertTimes, stlQueueDeleteTimes);
-}
\ No newline at end of file
+}
+
+TEST(PerformanceTests, StackAndQueuePerformanceWithNodePool) {
+    auto data = generateRandomNumbers(10000);
+
+    auto [stackInsertTimes, stackDeleteTimes] = measurePerformance<Stack>(data);
+    auto [queueInsertTimes, queueDeleteTimes] = measurePerformance<Queue>(data);
+    auto [pooledStackInsertTimes, pooledStackDeleteTimes] = measurePerformance<PooledStack>(data);
+    auto [pooledQueueInsertTimes, pooledQueueDeleteTimes] = measurePerformance<PooledQueue>(data);
+
+    std::cout << "\nHeap-allocated nodes (ms):\n";
+    printPerformanceTable(stackInsertTimes, stackDeleteTimes, queueInsertTimes, queueDeleteTimes);
+    std::cout << "\nNodePool-allocated nodes (ms):\n";
+    printPerformanceTable(pooledStackInsertTimes, pooledStackDeleteTimes, pooledQueueInsertTimes, pooledQueueDeleteTimes);
+}
+
+// Test suite for the contiguous ring buffer and the stack and queue built on it
+TEST(RingBufferTests, WrapsAroundWithIndexedAccess) {
+    RingBuffer<double> window(4);
+    EXPECT_EQ(window.capacity(), 4);
+    EXPECT_TRUE(window.empty());
+    EXPECT_THROW(window.pop_front(), std::out_of_range);
+    EXPECT_THROW(RingBuffer<double>(0), std::invalid_argument);
+
+    // Slide a window of four prices along ten; the oldest drops out as each new one arrives
+    for (int i = 0; i < 10; ++i) {
+        if (window.full()) window.pop_front();
+        window.push_back(100.0 + i);
+    }
+    EXPECT_TRUE(window.full());
+    EXPECT_THROW(window.push_back(0.0), std::length_error);
+    EXPECT_EQ(window.front(), 106.0);
+    EXPECT_EQ(window.back(), 109.0);
+    for (size_t i = 0; i < window.size(); ++i) {
+        EXPECT_EQ(window[i], 106.0 + i);
+    }
+    EXPECT_THROW(window.at(4), std::out_of_range);
+
+    // The contents wrap, so they come back as two runs that together hold the window in order
+    auto [first, second] = window.segments();
+    EXPECT_EQ(first.size + second.size, 4);
+    EXPECT_GT(second.size, 0);
+    std::vector<double> joined(first.data, first.data + first.size);
+    joined.insert(joined.end(), second.data, second.data + second.size);
+    EXPECT_EQ(joined, (std::vector<double>{106.0, 107.0, 108.0, 109.0}));
+
+    EXPECT_EQ(window.pop_back(), 109.0);
+    EXPECT_EQ(window.pop_front(), 106.0);
+    EXPECT_EQ(window.size(), 2);
+
+    // reserve() keeps the order and straightens the contents into one run
+    window.reserve(8);
+    EXPECT_EQ(window.capacity(), 8);
+    EXPECT_EQ(window.segments().first.size, 2);
+    EXPECT_EQ(window[0], 107.0);
+    EXPECT_EQ(window[1], 108.0);
+    window.clear();
+    EXPECT_TRUE(window.empty());
+}
+
+TEST(RingBufferTests, BatchOperations) {
+    RingBuffer<int> buffer(8);
+    std::vector<int> values(12);
+    std::iota(values.begin(), values.end(), 0);
+
+    EXPECT_EQ(buffer.push_back(values.data(), 6), 6);
+    EXPECT_EQ(buffer.pop_front(size_t(4)), 4);     // Drops 0..3
+    EXPECT_EQ(buffer.push_back(values.data() + 6, 6), 6);   // Wraps past the end of the array
+    EXPECT_TRUE(buffer.full());
+    EXPECT_EQ(buffer.push_back(values.data(), 1), 0);
+
+    std::vector<int> out(10, -1);
+    EXPECT_EQ(buffer.pop_front(out.data(), 5), 5);
+    EXPECT_EQ(std::vector<int>(out.begin(), out.begin() + 5), (std::vector<int>{4, 5, 6, 7, 8}));
+    EXPECT_EQ(buffer.pop_back(out.data(), 2), 2);
+    EXPECT_EQ(out[0], 11);
+    EXPECT_EQ(out[1], 10);
+    EXPECT_EQ(buffer.pop_front(out.data(), out.size()), 1);
+    EXPECT_EQ(out[0], 9);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.pop_front(out.data(), out.size()), 0);
+}
+
+TEST(RingBufferTests, StackAndQueueGrowAndKeepOrder) {
+    RingBufferStack<int> stack(2);
+    RingBufferQueue<int> queue(2);
+    EXPECT_THROW(stack.Remove(), std::out_of_range);
+    EXPECT_THROW(queue.Remove(), std::out_of_range);
+
+    for (int i = 0; i < 5; ++i) {
+        stack.Insert(i);
+        queue.Insert(i);
+    }
+    EXPECT_EQ(queue.Remove(), 0);   // Leaves the queue's contents wrapped before it grows again
+    std::vector<int> more = {5, 6, 7, 8, 9, 10};
+    stack.InsertBatch(more.data(), more.size());
+    queue.InsertBatch(more.data(), more.size());
+    EXPECT_EQ(stack.getSize(), 11);
+    EXPECT_EQ(queue.getSize(), 10);
+
+    std::vector<int> out(3);
+    EXPECT_EQ(stack.RemoveBatch(out.data(), out.size()), 3);
+    EXPECT_EQ(out, (std::vector<int>{10, 9, 8}));
+    EXPECT_EQ(queue.RemoveBatch(out.data(), out.size()), 3);
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3}));
+
+    for (int expected = 7; expected >= 0; --expected) {
+        EXPECT_EQ(stack.Remove(), expected);
+    }
+    for (int expected = 4; expected <= 10; ++expected) {
+        EXPECT_EQ(queue.Remove(), expected);
+    }
+    EXPECT_EQ(stack.getSize(), 0);
+    EXPECT_EQ(queue.getSize(), 0);
+}
+
+// std::deque driven through Insert/Remove so measurePerformance can time it like the others
+template <bool Lifo>
+class DequeAdapter {
+    std::deque<int> items;
+
+public:
+    void Insert(int value) { items.push_back(value); }
+    int Remove() {
+        int value = Lifo ? items.back() : items.front();
+        Lifo ? items.pop_back() : items.pop_front();
+        return value;
+    }
+};
+
+TEST(PerformanceTests, StackAndQueuePerformanceWithRingBuffer) {
+    auto data = generateRandomNumbers(10000);
+
+    auto [stackInsertTimes, stackDeleteTimes] = measurePerformance<Stack>(data);
+    auto [queueInsertTimes, queueDeleteTimes] = measurePerformance<Queue>(data);
+    auto [ringStackInsertTimes, ringStackDeleteTimes] = measurePerformance<RingBufferStack<int>>(data);
+    auto [ringQueueInsertTimes, ringQueueDeleteTimes] = measurePerformance<RingBufferQueue<int>>(data);
+    auto [dequeStackInsertTimes, dequeStackDeleteTimes] = measurePerformance<DequeAdapter<true>>(data);
+    auto [dequeQueueInsertTimes, dequeQueueDeleteTimes] = measurePerformance<DequeAdapter<false>>(data);
+
+    std::cout << "\nLinked nodes (ms):\n";
+    printPerformanceTable(stackInsertTimes, stackDeleteTimes, queueInsertTimes, queueDeleteTimes);
+    std::cout << "\nRing buffer (ms):\n";
+    printPerformanceTable(ringStackInsertTimes, ringStackDeleteTimes, ringQueueInsertTimes, ringQueueDeleteTimes);
+    std::cout << "\nstd::deque (ms):\n";
+    printPerformanceTable(dequeStackInsertTimes, dequeStackDeleteTimes, dequeQueueInsertTimes, dequeQueueDeleteTimes);
+}
+
+TEST(PerformanceTests, SlidingPriceWindow) {
+    const size_t windowSize = 200, steps = 2000000, batchSize = 64;
+    std::vector<double> prices(steps);
+    for (size_t i = 0; i < steps; ++i) prices[i] = 100.0 + static_cast<double>(i % 997) * 0.01;
+
+    // Keep the last windowSize prices and add up the window after every batch, so each version
+    // does the same pushes, pops and reads
+    auto time = [&](auto&& run) {
+        auto start = std::chrono::high_resolution_clock::now();
+        double checksum = run();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::make_pair(std::chrono::duration<double, std::milli>(end - start).count(), checksum);
+    };
+
+    auto [dequeTime, dequeSum] = time([&] {
+        std::deque<double> window;
+        double checksum = 0.0;
+        for (size_t i = 0; i < steps; i += batchSize) {
+            for (size_t j = i; j < i + batchSize; ++j) {
+                if (window.size() == windowSize) window.pop_front();
+                window.push_back(prices[j]);
+            }
+            checksum += std::accumulate(window.begin(), window.end(), 0.0);
+        }
+        return checksum;
+    });
+
+    auto [ringTime, ringSum] = time([&] {
+        RingBuffer<double> window(windowSize);
+        double checksum = 0.0;
+        for (size_t i = 0; i < steps; i += batchSize) {
+            size_t overflow = window.size() + batchSize > windowSize ? window.size() + batchSize - windowSize : 0;
+            window.pop_front(overflow);
+            window.push_back(prices.data() + i, batchSize);
+            auto [first, second] = window.segments();
+            checksum += std::accumulate(first.data, first.data + first.size, 0.0);
+            checksum += std::accumulate(second.data, second.data + second.size, 0.0);
+        }
+        return checksum;
+    });
+
+    EXPECT_NEAR(dequeSum, ringSum, 1e-6 * std::abs(dequeSum));
+    std::cout << "\nSliding window of " << windowSize << " over " << steps << " prices, batches of " << batchSize
+              << " (ms):\n" << std::fixed << std::setprecision(3) << std::right
+              << "  std::deque            " << std::setw(10) << dequeTime << "\n"
+              << "  RingBuffer batches    " << std::setw(10) << ringTime << "\n";
+}
+
+// Test suite for the lock-free ring-buffer queues
+template <typename Queue>
+void checkSingleThreadedQueue() {
+    Queue queue(5);     // Rounded up to 8
+    EXPECT_EQ(queue.getCapacity(), 8);
+    EXPECT_TRUE(queue.empty());
+
+    std::string value;
+    EXPECT_FALSE(queue.tryPop(value));
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.tryPush("BAR" + std::to_string(i)));
+    }
+    EXPECT_FALSE(queue.tryPush("overflow"));
+    EXPECT_EQ(queue.getSize(), 8);
+
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, "BAR0");
+
+    // Batches wrap around the end of the ring and stop at the capacity
+    std::vector<std::string> batch = {"A", "B", "C"};
+    EXPECT_EQ(queue.tryPushBatch(batch.begin(), batch.size()), 1);
+    std::vector<std::string> out(16);
+    EXPECT_EQ(queue.tryPopBatch(out.begin(), 4), 4);
+    EXPECT_EQ(out[0], "BAR1");
+    EXPECT_EQ(out[3], "BAR4");
+    EXPECT_EQ(queue.tryPushBatch(batch.begin(), batch.size()), 3);
+    size_t popped = queue.tryPopBatch(out.begin(), out.size());
+    EXPECT_EQ(popped, 7);
+    EXPECT_EQ(std::vector<std::string>(out.begin(), out.begin() + popped),
+              (std::vector<std::string>{"BAR5", "BAR6", "BAR7", "A", "A", "B", "C"}));
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.tryPopBatch(out.begin(), out.size()), 0);
+
+    // Elements still queued are destroyed with the queue
+    queue.tryPush(std::string(100, 'x'));
+    EXPECT_THROW(Queue(0), std::invalid_argument);
+}
+
+TEST(RingBufferQueueTests, SPSCSingleThreaded) {
+    checkSingleThreadedQueue<SPSCQueue<std::string>>();
+}
+
+TEST(RingBufferQueueTests, MPMCSingleThreaded) {
+    checkSingleThreadedQueue<MPMCQueue<std::string>>();
+}
+
+// Baseline for the queue benchmarks: std::queue behind one mutex, with the same interface
+template <typename T>
+class LockedQueue {
+private:
+    std::mutex mutex;
+    std::queue<T> queue;
+    size_t capacity;
+
+public:
+    explicit LockedQueue(size_t capacity = 1024) : capacity(capacity) {}
+
+    bool tryPush(const T& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.size() == capacity) return false;
+        queue.push(value);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) return false;
+        value = std::move(queue.front());
+        queue.pop();
+        return true;
+    }
+
+    template <typename InputIterator>
+    size_t tryPushBatch(InputIterator first, size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t pushed = std::min(count, capacity - queue.size());
+        for (size_t i = 0; i < pushed; ++i, ++first) queue.push(*first);
+        return pushed;
+    }
+
+    template <typename OutputIterator>
+    size_t tryPopBatch(OutputIterator out, size_t maxCount) {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t popped = std::min(maxCount, queue.size());
+        for (size_t i = 0; i < popped; ++i, ++out) {
+            *out = std::move(queue.front());
+            queue.pop();
+        }
+        return popped;
+    }
+};
+
+// Runs `producers` threads each pushing itemsPerProducer values tagged with their producer, and
+// `consumers` threads popping until every value is taken, using batches of batchSize (1 for single
+// operations). Checks that every value arrives exactly once and that each consumer sees each
+// producer's values in order. Returns millions of items per second.
+template <typename Queue>
+double measureQueueThroughput(size_t producers, size_t consumers, size_t itemsPerProducer, size_t batchSize) {
+    Queue queue(1024);
+    const uint64_t total = producers * itemsPerProducer;
+    std::atomic<uint64_t> consumed{0};
+    std::atomic<uint64_t> checksum{0};
+    std::atomic<bool> ordered{true};
+
+    auto produce = [&](size_t producer) {
+        std::vector<uint64_t> batch(batchSize);
+        for (size_t i = 0; i < itemsPerProducer;) {
+            size_t count = std::min(batchSize, itemsPerProducer - i);
+            for (size_t j = 0; j < count; ++j) batch[j] = (static_cast<uint64_t>(producer) << 40) | (i + j);
+            size_t pushed = batchSize == 1 ? (queue.tryPush(batch[0]) ? 1 : 0) : queue.tryPushBatch(batch.begin(), count);
+            if (pushed == 0) std::this_thread::yield();
+            i += pushed;
+        }
+    };
+
+    auto consume = [&]() {
+        std::vector<uint64_t> batch(batchSize);
+        std::vector<int64_t> lastSeen(producers, -1);
+        uint64_t localSum = 0;
+        while (consumed.load(std::memory_order_relaxed) < total) {
+            size_t popped = batchSize == 1 ? (queue.tryPop(batch[0]) ? 1 : 0) : queue.tryPopBatch(batch.begin(), batchSize);
+            if (popped == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t j = 0; j < popped; ++j) {
+                size_t producer = static_cast<size_t>(batch[j] >> 40);
+                int64_t index = static_cast<int64_t>(batch[j] & ((uint64_t(1) << 40) - 1));
+                if (index <= lastSeen[producer]) ordered = false;
+                lastSeen[producer] = index;
+                localSum += batch[j];
+            }
+            consumed.fetch_add(popped, std::memory_order_relaxed);
+        }
+        checksum.fetch_add(localSum);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) threads.emplace_back(produce, p);
+    for (size_t c = 0; c < consumers; ++c) threads.emplace_back(consume);
+    for (auto& thread : threads) thread.join();
+    auto end = std::chrono::steady_clock::now();
+
+    uint64_t expected = 0;
+    for (size_t p = 0; p < producers; ++p) {
+        expected += (static_cast<uint64_t>(p) << 40) * itemsPerProducer + itemsPerProducer * (itemsPerProducer - 1) / 2;
+    }
+    EXPECT_EQ(consumed.load(), total);
+    EXPECT_EQ(checksum.load(), expected);
+    EXPECT_TRUE(ordered.load());
+    return static_cast<double>(total) / std::chrono::duration<double>(end - start).count() / 1e6;
+}
+
+TEST(RingBufferQueueTests, MPMCDeliversEveryItemOnce) {
+    for (size_t batchSize : {1, 16}) {
+        measureQueueThroughput<MPMCQueue<uint64_t>>(4, 4, 50000, batchSize);
+        measureQueueThroughput<MPMCQueue<uint64_t>>(3, 1, 50000, batchSize);
+        measureQueueThroughput<MPMCQueue<uint64_t>>(1, 3, 50000, batchSize);
+    }
+    measureQueueThroughput<SPSCQueue<uint64_t>>(1, 1, 200000, 1);
+    measureQueueThroughput<SPSCQueue<uint64_t>>(1, 1, 200000, 16);
+}
+
+TEST(RingBufferQueuePerformanceTests, ThroughputByThreadCount) {
+    const size_t items = 400000;
+    size_t hardwareThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    std::cout << "\nQueue throughput, M items/s (" << hardwareThreads << " hardware threads):\n";
+    std::cout << std::left << std::setw(14) << "Producers" << std::setw(12) << "Consumers" << std::setw(8) << "Batch"
+              << std::setw(12) << "SPSCQueue" << std::setw(12) << "MPMCQueue" << "Mutex + std::queue\n";
+
+    for (auto [producers, consumers] : {std::pair<size_t, size_t>{1, 1}, {2, 2}, {4, 4}}) {
+        for (size_t batchSize : {1, 32}) {
+            size_t perProducer = items / producers;
+            std::string spsc = "-";
+            if (producers == 1 && consumers == 1) {
+                std::ostringstream rate;
+                rate << std::fixed << std::setprecision(2)
+                     << measureQueueThroughput<SPSCQueue<uint64_t>>(1, 1, perProducer, batchSize);
+                spsc = rate.str();
+            }
+            double mpmc = measureQueueThroughput<MPMCQueue<uint64_t>>(producers, consumers, perProducer, batchSize);
+            double locked = measureQueueThroughput<LockedQueue<uint64_t>>(producers, consumers, perProducer, batchSize);
+            std::cout << std::left << std::setw(14) << producers << std::setw(12) << consumers << std::setw(8) << batchSize
+                      << std::setw(12) << spsc << std::setw(12) << std::fixed << std::setprecision(2) << mpmc << locked << "\n";
+        }
+    }
+}
+
+// Median round trip of one item sent to an echo thread through one queue and back through another
+template <typename Queue>
+double measureRoundTripNanoseconds(size_t trips) {
+    Queue request(64), response(64);
+    std::thread echo([&]() {
+        uint64_t value;
+        for (size_t i = 0; i < trips; ++i) {
+            while (!request.tryPop(value)) std::this_thread::yield();
+            while (!response.tryPush(value)) std::this_thread::yield();
+        }
+    });
+
+    std::vector<double> samples(trips);
+    uint64_t value;
+    for (size_t i = 0; i < trips; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        while (!request.tryPush(i)) std::this_thread::yield();
+        while (!response.tryPop(value)) std::this_thread::yield();
+        auto end = std::chrono::steady_clock::now();
+        EXPECT_EQ(value, i);
+        samples[i] = std::chrono::duration<double, std::nano>(end - start).count();
+    }
+    echo.join();
+
+    std::nth_element(samples.begin(), samples.begin() + trips / 2, samples.end());
+    return samples[trips / 2];
+}
+
+TEST(RingBufferQueuePerformanceTests, RoundTripLatency) {
+    const size_t trips = 20000;
+    std::cout << "\nMedian round trip through two queues (ns):\n" << std::right << std::fixed << std::setprecision(0)
+              << "  SPSCQueue            " << std::setw(10) << measureRoundTripNanoseconds<SPSCQueue<uint64_t>>(trips) << "\n"
+              << "  MPMCQueue            " << std::setw(10) << measureRoundTripNanoseconds<MPMCQueue<uint64_t>>(trips) << "\n"
+              << "  Mutex + std::queue   " << std::setw(10) << measureRoundTripNanoseconds<LockedQueue<uint64_t>>(trips) << "\n";
+}
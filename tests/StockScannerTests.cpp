@@ -1,12 +1,25 @@
 #include <gtest/gtest.h>
 #include "../src/core/functions.h"
+#include "../src/core/range_index.h"
+#include "../src/core/symbol_table.h"
 #include "../src/database/database_utils.h"
 #include "../src/sorting/sorting_analysis.h"
+#include "../src/sorting/sorting_benchmark.h"
+#include "../src/sorting/top_k.h"
+#include "../src/sorting/kway_merge.h"
+#include "../src/sorting/simd_sort.h"
+#include "../src/screener/screen_rules.h"
+#include "../src/analysis/correlation_matrix.h"
+#include "../src/backtest/backtester.h"
 #include "test_helpers.h"
 #include <vector>
 #include <deque>
 #include <sqlite3.h>
 #include <algorithm>
+#include <cmath>
+#include <random>
+#include <limits>
+#include <cstdio>
 
 using namespace StockScanner;
 
@@ -169,7 +182,8 @@ TEST(SQLiteTests, TestInsertMultipleRecords) {
     };
     ASSERT_TRUE(insertStockData("TEST", data)) << "Failed to insert multiple records.";
 
-    std::vector<double> prices = getStockDataFromDatabase("TEST");
+    SymbolTable symbols;
+    std::vector<double> prices = getStockDataFromDatabase(symbols, symbols.intern("TEST"));
     ASSERT_EQ(prices.size(), 3) << "Expected 3 records for ticker TEST.";
     EXPECT_DOUBLE_EQ(prices[0], 100.5);
     EXPECT_DOUBLE_EQ(prices[1], 101.2);
@@ -188,7 +202,8 @@ TEST(SQLiteTests, TestDuplicateInsertion) {
     ASSERT_TRUE(insertStockData("TEST", data)) << "Initial insertion failed.";
     ASSERT_TRUE(insertStockData("TEST", data)) << "Duplicate insertion should be ignored.";
 
-    std::vector<double> prices = getStockDataFromDatabase("TEST");
+    SymbolTable symbols;
+    std::vector<double> prices = getStockDataFromDatabase(symbols, symbols.intern("TEST"));
     ASSERT_EQ(prices.size(), 1) << "Duplicate insertion should not add records.";
 
     closeDatabase();
@@ -199,7 +214,8 @@ TEST(SQLiteTests, TestDuplicateInsertion) {
 TEST(SQLiteTests, TestRetrieveFromEmptyDatabase) {
     initializeDatabase();
 
-    std::vector<double> prices = getStockDataFromDatabase("TEST");
+    SymbolTable symbols;
+    std::vector<double> prices = getStockDataFromDatabase(symbols, symbols.intern("TEST"));
     ASSERT_TRUE(prices.empty()) << "Expected no data for ticker TEST.";
 
     closeDatabase();
@@ -211,7 +227,8 @@ TEST(SQLiteTests, TestUninitializedDatabase) {
     // Directly test the functions without initializing the database
     ASSERT_FALSE(insertStockData("TEST", {{"2024-11-01 09:30:00", 100.5}})) << "Insertion should fail when database is uninitialized.";
     ASSERT_FALSE(checkStockDataExists("TEST")) << "Check should fail when database is uninitialized.";
-    ASSERT_TRUE(getStockDataFromDatabase("TEST").empty()) << "Retrieval should return empty when database is uninitialized.";
+    SymbolTable symbols;
+    ASSERT_TRUE(getStockDataFromDatabase(symbols, symbols.intern("TEST")).empty()) << "Retrieval should return empty when database is uninitialized.";
 }
 
 // Selection Sort Tests
@@ -296,4 +313,912 @@ TEST(SortingTests, CountingSortEdgeCases) {
     std::vector<double> duplicateData = {3.0, 1.0, 2.0, 1.0, 2.0};
     countingSort(duplicateData);
     EXPECT_TRUE(isSorted(duplicateData)); // Should handle duplicates
-}
\ No newline at end of file
+}
+
+// Screening Rule Tests
+TEST(ScreenRuleTests, EvaluatesCombinedCriteria) {
+    std::vector<double> prices = {100.0, 100.0, 100.0, 101.0, 103.0, 106.0, 110.0};
+
+    ScreenRule rule("pct_change(4) > 5 and sma(2) > sma(6) and up_run(3)");
+    EXPECT_TRUE(rule.evaluate(prices));
+    EXPECT_EQ(rule.lookback(), 6) << "sma(6) needs six prices, more than pct_change(4) and up_run(3).";
+
+    ScreenRule tooStrict("pct_change(4) > 15 or down_run(2)");
+    EXPECT_FALSE(tooStrict.evaluate(prices));
+}
+
+TEST(ScreenRuleTests, MatchesExistingCriteria) {
+    std::vector<double> prices = {100.0, 102.0, 101.0, 104.0, 106.0};
+
+    // pct_change over the whole series is the same move checkThreshold measures
+    ScreenRule threshold("pct_change(4) >= 5 or pct_change(4) <= -5");
+    EXPECT_EQ(threshold.evaluate(prices), checkThreshold(prices, 5.0));
+
+    // sma over the whole series is the average price
+    ScreenRule average("sma(5) == 102.6");
+    EXPECT_TRUE(average.evaluate(prices));
+
+    // up_run over the last window matches detectMomentum on the same window
+    std::deque<double> window = applySlidingWindow(std::deque<double>(prices.begin(), prices.end()), 3);
+    ScreenRule momentum("up_run(2)");
+    EXPECT_EQ(momentum.evaluate(prices), detectMomentum(window));
+}
+
+TEST(ScreenRuleTests, SharesDuplicateIndicators) {
+    ScreenRule rule("sma(5) > sma(20) and not (sma(5) > max(20)) and close() >= min(20) * 1.01");
+    EXPECT_EQ(rule.getIndicators().size(), 5) << "Repeated sma(5) should be computed once.";
+}
+
+TEST(ScreenRuleTests, ShortSeriesDoesNotMatch) {
+    ScreenRule rule("sma(10) > 0");
+    EXPECT_FALSE(rule.evaluate({1.0, 2.0, 3.0}));
+    EXPECT_FALSE(rule.evaluate({}));
+}
+
+TEST(ScreenRuleTests, RejectsMalformedRules) {
+    EXPECT_THROW(ScreenRule("sma(5) >"), std::invalid_argument);
+    EXPECT_THROW(ScreenRule("rsi(14) > 70"), std::invalid_argument);
+    EXPECT_THROW(ScreenRule("sma(0) > 1"), std::invalid_argument);
+    EXPECT_THROW(ScreenRule("(sma(5) > 1"), std::invalid_argument);
+    EXPECT_THROW(ScreenRule("sma(5) > 1 sma(3)"), std::invalid_argument);
+    EXPECT_THROW(ScreenRule("sma(1e30) > 1"), std::invalid_argument);
+    EXPECT_THROW(ScreenRule("sma(0x10) > 1"), std::invalid_argument);
+    EXPECT_THROW(ScreenRule("sma(5.0) > 1"), std::invalid_argument);
+    EXPECT_THROW(ScreenRule("sma(99999999999999999999999) > 1"), std::invalid_argument);
+    EXPECT_NO_THROW(ScreenRule("sma(" + std::to_string(ScreenRule::MAX_PERIOD) + ") > 1"));
+    EXPECT_THROW(ScreenRule("sma(" + std::to_string(ScreenRule::MAX_PERIOD + 1) + ") > 1"), std::invalid_argument);
+}
+
+TEST(ScreenRuleTests, ReusedWorkspaceMatchesFreshEvaluation) {
+    ScreenRule rule("-(sma(2) - sma(3)) < 0 and not (close() > 2 * (max(3) + 1 * (min(2) + 3)))");
+    ScreenRule::Workspace workspace = rule.makeWorkspace();
+    const double* valuesBefore = workspace.values.data();
+    const double* stackBefore = workspace.stack.data();
+
+    std::vector<std::vector<double>> series = {
+        {1.0, 2.0, 3.0}, {3.0, 2.0, 1.0}, {5.0, 5.0, 5.0, 5.0}, {1.0, 4.0, 9.0, 16.0}};
+    for (const auto& prices : series) {
+        EXPECT_EQ(rule.evaluate(prices, workspace), rule.evaluate(prices));
+    }
+    EXPECT_EQ(workspace.values.data(), valuesBefore) << "Evaluation should not reallocate the workspace.";
+    EXPECT_EQ(workspace.stack.data(), stackBefore);
+
+    // A workspace sized for a smaller rule is regrown rather than overrun
+    ScreenRule::Workspace small = ScreenRule("close() > 0").makeWorkspace();
+    EXPECT_EQ(rule.evaluate(series[3], small), rule.evaluate(series[3]));
+}
+
+TEST(ScreenRuleTests, ScreensUniverse) {
+    SymbolTable symbols;
+    std::vector<std::vector<double>> universe(4);
+    universe[symbols.intern("UP")] = {10.0, 11.0, 12.0, 13.0};
+    universe[symbols.intern("DOWN")] = {13.0, 12.0, 11.0, 10.0};
+    universe[symbols.intern("FLAT")] = {10.0, 10.0, 10.0, 10.0};
+    universe[symbols.intern("ALSOUP")] = {20.0, 21.0, 23.0, 26.0};
+
+    ScreenRule rule("up_run(3) and pct_change(3) > 10");
+    std::vector<SymbolId> matches = screenUniverse(rule, universe);
+    EXPECT_EQ(matches, (std::vector<SymbolId>{*symbols.find("UP"), *symbols.find("ALSOUP")}));
+
+    // Ranked by percent change over the whole series: ALSOUP +30%, UP +30% (tie, interned first wins)
+    SymbolId shortSeries = symbols.intern("SHORT");
+    universe.resize(symbols.size());
+    universe[shortSeries] = {5.0};    // Too few prices to have a percent change
+    std::vector<ScanRecord> ranked = rankUniverse(ScreenRule("close() > 0"), universe, 3);
+    ASSERT_EQ(ranked.size(), 3u);
+    EXPECT_EQ(symbols.name(ranked[0].symbol), "UP");
+    EXPECT_DOUBLE_EQ(ranked[0].metric, 30.0);
+    EXPECT_EQ(symbols.name(ranked[1].symbol), "ALSOUP");
+    EXPECT_EQ(symbols.name(ranked[2].symbol), "FLAT");
+    EXPECT_TRUE(rankUniverse(ScreenRule("close() > 100"), universe, 3).empty());
+}
+
+// Test loading aligned series for several tickers
+TEST(SQLiteTests, TestAlignedStockData) {
+    initializeDatabase();
+    ASSERT_TRUE(insertStockData("AAA", {{"2024-11-01 09:30:00", 10.0}, {"2024-11-01 09:35:00", 11.0},
+                                        {"2024-11-01 09:40:00", 12.0}}));
+    ASSERT_TRUE(insertStockData("BBB", {{"2024-11-01 09:35:00", 21.0}, {"2024-11-01 09:40:00", 22.0},
+                                        {"2024-11-01 09:45:00", 23.0}}));
+
+    SymbolTable symbols;
+    auto aligned = getAlignedStockDataFromDatabase(symbols, {symbols.intern("AAA"), symbols.intern("BBB")});
+    ASSERT_EQ(aligned.size(), 2);
+    EXPECT_EQ(aligned[0], (std::vector<double>{11.0, 12.0})) << "Only datetimes shared by both tickers are kept.";
+    EXPECT_EQ(aligned[1], (std::vector<double>{21.0, 22.0}));
+
+    closeDatabase();
+    std::remove("stock_data.db");
+}
+
+TEST(SQLiteTests, TestStockBars) {
+    initializeDatabase();
+    ASSERT_TRUE(insertStockData("AAA", {{"2024-11-01 09:35:00", 11.0}, {"2024-11-01 09:30:00", 10.0}}));
+
+    SymbolTable symbols;
+    auto bars = getStockBarsFromDatabase(symbols, {symbols.intern("AAA"), symbols.intern("ZZZ")});
+    ASSERT_EQ(bars.size(), 2);
+    ASSERT_EQ(bars[0].size(), 2);
+    EXPECT_EQ(bars[0][0].timestamp, parseTimestamp("2024-11-01 09:30:00"));
+    EXPECT_DOUBLE_EQ(bars[0][0].close, 10.0);
+    EXPECT_EQ(bars[0][1].timestamp - bars[0][0].timestamp, 300);
+    EXPECT_TRUE(bars[1].empty()) << "Unknown tickers load as empty series.";
+
+    closeDatabase();
+    std::remove("stock_data.db");
+}
+
+TEST(SQLiteTests, TestAllStockSeriesBySymbol) {
+    initializeDatabase();
+    ASSERT_TRUE(insertStockData("BBB", {{"2024-11-01 09:35:00", 21.0}, {"2024-11-01 09:30:00", 20.0}}));
+    ASSERT_TRUE(insertStockData("AAA", {{"2024-11-01 09:30:00", 10.0}}));
+
+    // IDs already in the table are kept; new tickers get the next IDs
+    SymbolTable symbols;
+    SymbolId bbb = symbols.intern("BBB");
+    SymbolId unused = symbols.intern("ZZZ");
+    auto series = getAllStockSeriesFromDatabase(symbols);
+
+    ASSERT_EQ(series.size(), 3u);
+    SymbolId aaa = *symbols.find("AAA");
+    EXPECT_EQ(aaa, 2u);
+    EXPECT_EQ(series[aaa], std::vector<double>({10.0}));
+    EXPECT_EQ(series[bbb], std::vector<double>({20.0, 21.0}));
+    EXPECT_TRUE(series[unused].empty());
+
+    closeDatabase();
+    std::remove("stock_data.db");
+}
+
+TEST(SQLiteTests, TestBacktestUniverseBySymbol) {
+    initializeDatabase();
+    ASSERT_TRUE(insertStockData("AAA", {{"2024-11-01 09:30:00", 10.0}, {"2024-11-01 09:35:00", 11.0}}));
+
+    SymbolTable symbols;
+    SymbolId unused = symbols.intern("ZZZ");
+    SymbolId aaa = symbols.intern("AAA");
+    auto universe = loadBacktestUniverse(symbols, {aaa});
+    ASSERT_EQ(universe.size(), symbols.size()) << "The universe is indexed by SymbolId.";
+    EXPECT_EQ(universe[aaa], std::vector<double>({10.0, 11.0}));
+    EXPECT_TRUE(universe[unused].empty());
+
+    closeDatabase();
+    std::remove("stock_data.db");
+}
+
+TEST(TimeframeTests, InternsSupportedTimeframes) {
+    const SymbolTable& timeframes = timeframeSymbols();
+    EXPECT_EQ(timeframes.size(), 4u);
+    for (const char* name : {"5min", "15min", "daily", "hourly"}) {
+        std::optional<SymbolId> id = timeframes.find(name);
+        ASSERT_TRUE(id.has_value()) << name;
+        EXPECT_FALSE(timeframeInfo(*id).apiFunction.empty());
+    }
+    EXPECT_EQ(timeframes.name(defaultTimeframe()), "daily");
+    EXPECT_EQ(timeframeInfo(defaultTimeframe()).jsonKey, "Time Series (Daily)");
+    EXPECT_FALSE(timeframes.find("weekly").has_value());
+    EXPECT_THROW(timeframeInfo(static_cast<SymbolId>(timeframes.size())), std::out_of_range);
+}
+
+TEST(SQLiteTests, TestParseTimestamp) {
+    EXPECT_EQ(parseTimestamp("1970-01-01"), 0);
+    EXPECT_EQ(parseTimestamp("2000-03-01"), 951868800);
+    EXPECT_EQ(parseTimestamp("2024-11-01 09:30:00"), 1730453400);
+    EXPECT_EQ(parseTimestamp("2024-11-01 09:30"), 1730453400);
+    EXPECT_THROW(parseTimestamp("11/01/2024"), std::invalid_argument);
+    EXPECT_THROW(parseTimestamp("2024-13-01"), std::invalid_argument);
+    EXPECT_THROW(parseTimestamp("2024-11-01 09:30:00Z"), std::invalid_argument);
+    EXPECT_THROW(parseTimestamp("2024-11-01T09:30:00"), std::invalid_argument);
+    EXPECT_THROW(parseTimestamp("2024-11-01garbage"), std::invalid_argument);
+    EXPECT_THROW(parseTimestamp("2024-11-01 09"), std::invalid_argument);
+}
+
+// Reference sample covariance computed directly from the window
+static double naiveCovariance(const std::vector<double>& x, const std::vector<double>& y, size_t begin, size_t window) {
+    double meanX = 0.0, meanY = 0.0;
+    for (size_t t = begin; t < begin + window; ++t) {
+        meanX += x[t];
+        meanY += y[t];
+    }
+    meanX /= window;
+    meanY /= window;
+
+    double total = 0.0;
+    for (size_t t = begin; t < begin + window; ++t) {
+        total += (x[t] - meanX) * (y[t] - meanY);
+    }
+    return total / (window - 1);
+}
+
+// Correlation Matrix Tests
+TEST(CorrelationMatrixTests, MatchesNaiveComputationAndUpdatesIncrementally) {
+    const size_t seriesCount = 70;  // Spans more than one tile
+    const size_t window = 30;
+    const size_t bars = 40;
+
+    std::mt19937 gen(42);
+    std::normal_distribution<> noise(0.0, 0.01);
+    std::vector<std::vector<double>> returns(seriesCount, std::vector<double>(bars));
+    for (size_t t = 0; t < bars; ++t) {
+        double market = noise(gen);
+        for (size_t i = 0; i < seriesCount; ++i) {
+            returns[i][t] = (i % 2 == 0 ? market : -market) + noise(gen);
+        }
+    }
+
+    // Build on the first `window` bars, then slide one bar at a time to the end
+    std::vector<std::vector<double>> initial(seriesCount);
+    for (size_t i = 0; i < seriesCount; ++i) {
+        initial[i].assign(returns[i].begin(), returns[i].begin() + window);
+    }
+    RollingCorrelationMatrix matrix(seriesCount, window);
+    matrix.build(initial);
+
+    for (size_t t = window; t < bars; ++t) {
+        std::vector<double> bar(seriesCount);
+        for (size_t i = 0; i < seriesCount; ++i) bar[i] = returns[i][t];
+        matrix.update(bar);
+    }
+
+    const size_t begin = bars - window;
+    for (size_t i : {0, 1, 33, 64, 69}) {
+        for (size_t j : {0, 2, 63, 69}) {
+            double expected = naiveCovariance(returns[i], returns[j], begin, window);
+            EXPECT_NEAR(matrix.covariance(i, j), expected, 1e-12);
+            EXPECT_DOUBLE_EQ(matrix.covariance(i, j), matrix.covariance(j, i));
+
+            double expectedCorrelation = expected / std::sqrt(naiveCovariance(returns[i], returns[i], begin, window) *
+                                                              naiveCovariance(returns[j], returns[j], begin, window));
+            EXPECT_NEAR(matrix.correlation(i, j), expectedCorrelation, 1e-9);
+        }
+    }
+
+    std::vector<double> correlations = matrix.correlationMatrix();
+    EXPECT_NEAR(correlations[5 * seriesCount + 5], 1.0, 1e-12);
+    EXPECT_GT(correlations[0 * seriesCount + 2], 0.0) << "Series driven the same way should correlate positively.";
+    EXPECT_LT(correlations[0 * seriesCount + 1], 0.0) << "Series driven in opposite ways should correlate negatively.";
+}
+
+TEST(CorrelationMatrixTests, LongRollMatchesFromScratchComputation) {
+    const size_t seriesCount = 3;
+    const size_t window = 25;
+    const size_t bars = 20000;
+
+    // Series with a large offset and small spread are where raw sums of squares lose precision
+    std::mt19937 gen(7);
+    std::normal_distribution<> noise(0.0, 1e-4);
+    std::vector<std::vector<double>> returns(seriesCount, std::vector<double>(bars));
+    for (size_t t = 0; t < bars; ++t) {
+        double common = noise(gen);
+        returns[0][t] = 1000.0 + common + noise(gen);
+        returns[1][t] = -500.0 - common + noise(gen);
+        returns[2][t] = 0.01 * std::sin(t * 0.001) + noise(gen);
+    }
+
+    std::vector<std::vector<double>> initial(seriesCount);
+    for (size_t i = 0; i < seriesCount; ++i) {
+        initial[i].assign(returns[i].begin(), returns[i].begin() + window);
+    }
+    RollingCorrelationMatrix matrix(seriesCount, window);
+    matrix.build(initial);
+
+    std::vector<double> bar(seriesCount);
+    for (size_t t = window; t < bars; ++t) {
+        for (size_t i = 0; i < seriesCount; ++i) bar[i] = returns[i][t];
+        matrix.update(bar);
+
+        // Check at points that do not coincide with the periodic recomputation
+        if (t % 997 != 0 && t != bars - 1) continue;
+        const size_t begin = t + 1 - window;
+        for (size_t i = 0; i < seriesCount; ++i) {
+            for (size_t j = i; j < seriesCount; ++j) {
+                double expected = naiveCovariance(returns[i], returns[j], begin, window);
+                EXPECT_NEAR(matrix.covariance(i, j), expected, 1e-12) << "bar " << t << " pair " << i << "," << j;
+                double expectedCorrelation = expected / std::sqrt(naiveCovariance(returns[i], returns[i], begin, window) *
+                                                                  naiveCovariance(returns[j], returns[j], begin, window));
+                EXPECT_NEAR(matrix.correlation(i, j), expectedCorrelation, 1e-6);
+            }
+        }
+    }
+}
+
+TEST(CorrelationMatrixTests, RejectsShortSeries) {
+    RollingCorrelationMatrix matrix(2, 5);
+    EXPECT_THROW(matrix.build({{0.1, 0.2}, {0.1, 0.2}}), std::invalid_argument);
+    EXPECT_THROW(RollingCorrelationMatrix(2, 1), std::invalid_argument);
+}
+
+TEST(CorrelationMatrixTests, ReturnsFromPrices) {
+    std::vector<double> returns = calculateReturns({100.0, 110.0, 99.0});
+    ASSERT_EQ(returns.size(), 2);
+    EXPECT_NEAR(returns[0], 0.10, 1e-12);
+    EXPECT_NEAR(returns[1], -0.10, 1e-12);
+
+    // A zero price has no defined return and is recorded as 0 rather than dividing by zero
+    returns = calculateReturns({0.0, 5.0, 10.0});
+    ASSERT_EQ(returns.size(), 2);
+    EXPECT_EQ(returns[0], 0.0);
+    EXPECT_NEAR(returns[1], 1.0, 1e-12);
+}
+
+// Rolling Median and Percentile Tests
+TEST(RollingPercentileTests, MatchesSortedWindows) {
+    std::vector<double> prices = {10.0, 12.0, 11.0, 15.0, 14.0, 14.0, 9.0, 13.0, 16.0, 12.0};
+    const size_t windowSize = 4;
+
+    std::vector<double> medians = calculateRollingMedian(prices, windowSize);
+    std::vector<double> upperQuartiles = calculateRollingPercentile(prices, windowSize, 75.0);
+    ASSERT_EQ(medians.size(), prices.size() - windowSize + 1);
+    ASSERT_EQ(upperQuartiles.size(), medians.size());
+
+    for (size_t start = 0; start < medians.size(); ++start) {
+        std::vector<double> window(prices.begin() + start, prices.begin() + start + windowSize);
+        std::sort(window.begin(), window.end());
+        EXPECT_DOUBLE_EQ(medians[start], (window[1] + window[2]) / 2.0);
+        EXPECT_DOUBLE_EQ(upperQuartiles[start], window[2] + 0.25 * (window[3] - window[2]));
+    }
+}
+
+TEST(RollingPercentileTests, EdgeCases) {
+    std::vector<double> prices = {3.0, 1.0, 2.0};
+    EXPECT_TRUE(calculateRollingMedian(prices, 0).empty());
+    EXPECT_TRUE(calculateRollingMedian(prices, 4).empty());
+    EXPECT_EQ(calculateRollingMedian(prices, 1), prices) << "A window of one is the series itself.";
+    EXPECT_EQ(calculateRollingPercentile(prices, 3, 0.0), (std::vector<double>{1.0}));
+    EXPECT_EQ(calculateRollingPercentile(prices, 3, 100.0), (std::vector<double>{3.0}));
+}
+
+// Backtesting Tests
+TEST(BacktestTests, SignalsMatchThresholdAndMomentumChecks) {
+    std::mt19937 gen(11);
+    std::normal_distribution<> move(0.1, 1.0);
+    std::vector<double> prices = {100.0};
+    for (int i = 0; i < 500; ++i) {
+        prices.push_back(prices.back() + move(gen));
+    }
+
+    BacktestParameters parameters{2.0, 4};
+    BacktestResult result = runBacktest({prices}, parameters, 3);
+
+    // Count the same signals by slicing every window and calling the existing checks
+    size_t thresholdHits = 0, momentumHits = 0;
+    for (size_t end = parameters.windowSize; end <= prices.size(); ++end) {
+        std::vector<double> window(prices.begin() + (end - parameters.windowSize), prices.begin() + end);
+        thresholdHits += checkThreshold(window, parameters.threshold);
+        momentumHits += detectMomentum(std::deque<double>(window.begin(), window.end()));
+    }
+
+    EXPECT_EQ(result.barsReplayed, prices.size());
+    EXPECT_EQ(result.thresholdHits, thresholdHits);
+    EXPECT_EQ(result.momentumHits, momentumHits);
+    for (const auto& trade : result.trades) {
+        EXPECT_EQ(trade.exitBar, trade.entryBar + 3);
+        EXPECT_NEAR(trade.returnPercent, (prices[trade.exitBar] - prices[trade.entryBar]) / prices[trade.entryBar] * 100, 1e-9);
+    }
+}
+
+TEST(BacktestTests, RecordsTradeOutcomes) {
+    // Rises for four bars, then falls: one entry at bar 3 exiting two bars later at a loss
+    std::vector<double> prices = {100.0, 102.0, 104.0, 107.0, 105.0, 103.0, 101.0};
+    BacktestResult result = runBacktest({prices}, {5.0, 4}, 2);
+
+    ASSERT_EQ(result.trades.size(), 1);
+    EXPECT_EQ(result.trades[0].entryBar, 3);
+    EXPECT_EQ(result.trades[0].exitBar, 5);
+    EXPECT_EQ(result.wins, 0);
+    EXPECT_NEAR(result.averageReturnPercent, (103.0 - 107.0) / 107.0 * 100, 1e-9);
+}
+
+TEST(BacktestTests, ParameterSweepMatchesIndividualRuns) {
+    std::vector<std::vector<double>> universe = {
+        {10.0, 10.5, 11.0, 11.8, 11.2, 11.9, 12.5, 13.4, 13.0, 12.1, 12.9, 13.8},
+        {50.0, 49.0, 51.0, 53.0, 55.5, 54.0, 56.0, 58.0, 61.0, 60.0}
+    };
+    std::vector<double> thresholds = {1.0, 3.0, 6.0};
+    std::vector<size_t> windowSizes = {2, 3, 4};
+
+    std::vector<BacktestResult> sweep = runParameterSweep(universe, thresholds, windowSizes, 1);
+    ASSERT_EQ(sweep.size(), thresholds.size() * windowSizes.size());
+
+    for (size_t t = 0; t < thresholds.size(); ++t) {
+        for (size_t w = 0; w < windowSizes.size(); ++w) {
+            const BacktestResult& fromSweep = sweep[t * windowSizes.size() + w];
+            BacktestResult single = runBacktest(universe, {thresholds[t], windowSizes[w]}, 1);
+            EXPECT_DOUBLE_EQ(fromSweep.parameters.threshold, thresholds[t]);
+            EXPECT_EQ(fromSweep.parameters.windowSize, windowSizes[w]);
+            EXPECT_EQ(fromSweep.trades.size(), single.trades.size());
+            EXPECT_DOUBLE_EQ(fromSweep.averageReturnPercent, single.averageReturnPercent);
+            for (const auto& trade : fromSweep.trades) {
+                EXPECT_LT(trade.exitBar, universe[trade.symbol].size()) << "Trades are tagged with their series' SymbolId.";
+            }
+        }
+    }
+}
+
+// Range Index Tests
+TEST(RangeIndexTests, MatchesScanOfEveryWindow) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<> dis(95.0, 105.0);
+    std::vector<double> prices(37);
+    std::generate(prices.begin(), prices.end(), [&]() { return dis(gen); });
+
+    RangeIndex index(prices);
+    ASSERT_EQ(index.size(), prices.size());
+
+    for (size_t start = 0; start < prices.size(); ++start) {
+        for (size_t length = 1; start + length <= prices.size(); ++length) {
+            std::vector<double> window(prices.begin() + start, prices.begin() + start + length);
+            double mean = calculateAveragePrice(window);
+            double squares = 0.0;
+            for (double price : window) squares += (price - mean) * (price - mean);
+
+            ASSERT_NEAR(index.mean(start, length), mean, 1e-9);
+            ASSERT_NEAR(index.sum(start, length), mean * length, 1e-8);
+            ASSERT_NEAR(index.variance(start, length), length > 1 ? squares / (length - 1) : 0.0, 1e-8);
+            ASSERT_DOUBLE_EQ(index.minimum(start, length), *std::min_element(window.begin(), window.end()));
+            ASSERT_DOUBLE_EQ(index.maximum(start, length), *std::max_element(window.begin(), window.end()));
+        }
+    }
+}
+
+TEST(RangeIndexTests, AppendMatchesBuild) {
+    std::vector<double> prices = {5.0, 3.0, 8.0, 1.0, 9.0, 2.0, 7.0, 4.0, 6.0};
+    RangeIndex built(prices);
+    RangeIndex appended;
+    for (double price : prices) {
+        appended.append(price);
+    }
+
+    for (size_t start = 0; start < prices.size(); ++start) {
+        for (size_t length = 1; start + length <= prices.size(); ++length) {
+            EXPECT_DOUBLE_EQ(appended.mean(start, length), built.mean(start, length));
+            EXPECT_DOUBLE_EQ(appended.minimum(start, length), built.minimum(start, length));
+            EXPECT_DOUBLE_EQ(appended.maximum(start, length), built.maximum(start, length));
+        }
+    }
+}
+
+TEST(RangeIndexTests, RejectsWindowsOutsideSeries) {
+    RangeIndex index({1.0, 2.0, 3.0});
+    EXPECT_THROW(index.mean(0, 0), std::out_of_range);
+    EXPECT_THROW(index.minimum(2, 2), std::out_of_range);
+    EXPECT_THROW(index.maximum(3, 1), std::out_of_range);
+    EXPECT_THROW(RangeIndex().sum(0, 1), std::out_of_range);
+}
+
+// Parallel Merge Sort Tests
+TEST(SortingTests, ParallelMergeSortCorrectness) {
+    std::vector<double> data = {5.0, 3.0, 4.0, 1.0, 2.0};
+    parallelMergeSort(data);
+    EXPECT_TRUE(isSorted(data));
+}
+
+TEST(SortingTests, ParallelMergeSortEdgeCases) {
+    std::vector<double> emptyData;
+    parallelMergeSort(emptyData);
+    EXPECT_TRUE(isSorted(emptyData)); // Should handle empty vector
+
+    std::vector<double> singleElementData = {42.0};
+    parallelMergeSort(singleElementData);
+    EXPECT_TRUE(isSorted(singleElementData)); // Should handle single element
+
+    std::vector<double> duplicateData = {3.0, 1.0, 2.0, 1.0, 2.0};
+    parallelMergeSort(duplicateData);
+    EXPECT_TRUE(isSorted(duplicateData)); // Should handle duplicates
+}
+
+TEST(SortingTests, ParallelMergeSortMatchesStdSortOnLargeInput) {
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<> dis(-50.0, 50.0);
+
+    // Sizes around the insertion sort cutoff and above the per-thread chunk size
+    for (size_t size : {31, 33, 1000, 300001}) {
+        std::vector<double> data(size);
+        std::generate(data.begin(), data.end(), [&]() { return std::round(dis(gen)); });
+        std::vector<double> expected = data;
+        std::sort(expected.begin(), expected.end());
+
+        parallelMergeSort(data);
+        EXPECT_EQ(data, expected) << "Mismatch for size " << size;
+    }
+}
+
+// Radix Sort Tests
+TEST(SortingTests, RadixSortCorrectness) {
+    std::vector<double> data = {5.0, 3.0, 4.0, 1.0, 2.0};
+    radixSort(data);
+    EXPECT_TRUE(isSorted(data));
+}
+
+TEST(SortingTests, RadixSortEdgeCases) {
+    std::vector<double> emptyData;
+    radixSort(emptyData);
+    EXPECT_TRUE(isSorted(emptyData)); // Should handle empty vector
+
+    std::vector<double> singleElementData = {42.0};
+    radixSort(singleElementData);
+    EXPECT_TRUE(isSorted(singleElementData)); // Should handle single element
+
+    std::vector<double> duplicateData = {3.0, 1.0, 2.0, 1.0, 2.0};
+    radixSort(duplicateData);
+    EXPECT_TRUE(isSorted(duplicateData)); // Should handle duplicates
+}
+
+TEST(SortingTests, RadixSortIsExactForAnyRange) {
+    // Negative returns, sub-cent differences and values far apart, which countingSort cannot represent
+    std::vector<double> data = {0.0012345, -3.5, 1e12, -1e-9, 187.123456789, 187.123456788,
+                                -std::numeric_limits<double>::infinity(), 0.0, -250000.75,
+                                std::numeric_limits<double>::infinity(), 1e-300, -0.0001};
+    std::vector<double> expected = data;
+    std::sort(expected.begin(), expected.end());
+
+    radixSort(data);
+    EXPECT_EQ(data, expected);
+
+    std::mt19937 gen(9);
+    std::normal_distribution<> returns(0.0, 0.02);
+    std::vector<double> randomData(100000);
+    std::generate(randomData.begin(), randomData.end(), [&]() { return returns(gen); });
+    expected = randomData;
+    std::sort(expected.begin(), expected.end());
+
+    radixSort(randomData);
+    EXPECT_EQ(randomData, expected);
+}
+
+TEST(SortingTests, RadixSortPairsIsStable) {
+    std::vector<std::pair<double, size_t>> records = {{2.5, 0}, {-1.0, 1}, {2.5, 2}, {0.5, 3}, {-1.0, 4}, {2.5, 5}};
+    radixSortPairs(records);
+
+    std::vector<std::pair<double, size_t>> expected = {{-1.0, 1}, {-1.0, 4}, {0.5, 3}, {2.5, 0}, {2.5, 2}, {2.5, 5}};
+    EXPECT_EQ(records, expected);
+}
+
+// Sorting benchmark harness tests
+TEST(SortBenchmarkTests, GeneratesEveryInputShape) {
+    std::mt19937 gen(21);
+    std::vector<double> closePrices = {10.0, 10.5, 10.25};
+
+    std::vector<double> sorted = generateSortInput(InputShape::Sorted, 1000, gen, closePrices);
+    EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+
+    std::vector<double> reverse = generateSortInput(InputShape::Reverse, 1000, gen, closePrices);
+    EXPECT_TRUE(std::is_sorted(reverse.rbegin(), reverse.rend()));
+
+    std::vector<double> nearlySorted = generateSortInput(InputShape::NearlySorted, 1000, gen, closePrices);
+    EXPECT_FALSE(std::is_sorted(nearlySorted.begin(), nearlySorted.end()));
+    size_t descents = 0;
+    for (size_t i = 1; i < nearlySorted.size(); ++i) descents += nearlySorted[i] < nearlySorted[i - 1];
+    EXPECT_LE(descents, 20u);
+
+    std::vector<double> duplicates = generateSortInput(InputShape::ManyDuplicates, 1000, gen, closePrices);
+    std::sort(duplicates.begin(), duplicates.end());
+    EXPECT_LE(std::unique(duplicates.begin(), duplicates.end()) - duplicates.begin(), 16);
+
+    std::vector<double> prices = generateSortInput(InputShape::ClosePrices, 7, gen, closePrices);
+    EXPECT_EQ(prices, std::vector<double>({10.0, 10.5, 10.25, 10.0, 10.5, 10.25, 10.0}));
+    EXPECT_TRUE(generateSortInput(InputShape::ClosePrices, 7, gen, {}).empty());
+}
+
+TEST(SortBenchmarkTests, TimesEveryRegisteredAlgorithm) {
+    std::mt19937 gen(22);
+    std::vector<double> data = generateSortInput(InputShape::Random, 2000, gen, {});
+
+    for (const auto& algorithm : sortAlgorithms()) {
+        bool sorted = false;
+        std::vector<double> times = timeSortTrials(data, algorithm.sort, 1, 3, sorted);
+        EXPECT_EQ(times.size(), 3u) << algorithm.name;
+        EXPECT_TRUE(sorted) << algorithm.name;
+    }
+
+    bool sorted = true;
+    timeSortTrials(data, [](std::vector<double>&) {}, 0, 1, sorted);
+    EXPECT_FALSE(sorted);
+}
+
+TEST(SortBenchmarkTests, ParsesCommandLineOptions) {
+    const char* args[] = {"StockScanner", "--sort-benchmark", "--algorithms=RadixSort,std::sort",
+                          "--shapes=sorted,duplicates", "--sizes=10,100000000", "--trials=7", "--warmup=2",
+                          "--output=out"};
+    SortBenchmarkConfig config;
+    ASSERT_TRUE(parseSortBenchmarkArgs(8, const_cast<char**>(args), config));
+
+    EXPECT_EQ(config.algorithms, std::vector<std::string>({"RadixSort", "std::sort"}));
+    EXPECT_EQ(config.shapes, std::vector<InputShape>({InputShape::Sorted, InputShape::ManyDuplicates}));
+    EXPECT_EQ(config.sizes, std::vector<size_t>({10, 100000000}));
+    EXPECT_EQ(config.trials, 7u);
+    EXPECT_EQ(config.warmupRuns, 2u);
+    EXPECT_EQ(config.outputPrefix, "out");
+
+    const char* badShape[] = {"StockScanner", "--sort-benchmark", "--shapes=zigzag"};
+    EXPECT_FALSE(parseSortBenchmarkArgs(3, const_cast<char**>(badShape), config));
+    const char* badSize[] = {"StockScanner", "--sort-benchmark", "--sizes=many"};
+    EXPECT_FALSE(parseSortBenchmarkArgs(3, const_cast<char**>(badSize), config));
+}
+
+TEST(SortBenchmarkTests, SummarizesEachCell) {
+    SortBenchmarkConfig config;
+    config.algorithms = {"SelectionSort", "RadixSort"};
+    config.shapes = {InputShape::Random, InputShape::ManyDuplicates};
+    config.sizes = {100, 200000};
+    config.trials = 3;
+    config.outputPrefix = "test_sorting_benchmark";
+
+    std::vector<SortBenchmarkResult> results = runSortBenchmark(config);
+
+    // SelectionSort is capped below 200000, so it only runs the small size
+    ASSERT_EQ(results.size(), 6u);
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.sorted);
+        EXPECT_EQ(result.trials, 3u);
+        EXPECT_LE(result.minimum, result.median);
+        EXPECT_LE(result.median, result.p95);
+    }
+    std::remove("test_sorting_benchmark.csv");
+    std::remove("test_sorting_benchmark.json");
+}
+
+// Top-K ranking tests
+TEST(TopKTests, SelectsHighestAndLowestMovers) {
+    SymbolTable symbols;
+    auto record = [&symbols](const char* ticker, double metric) { return ScanRecord{symbols.intern(ticker), metric}; };
+    std::vector<ScanRecord> records = {record("AAPL", 2.5), record("MSFT", -1.0), record("TSLA", 7.25),
+                                       record("AMZN", 0.5), record("NVDA", 7.25), record("META", -3.0)};
+
+    // TSLA and NVDA tie; TSLA was interned first so it ranks higher
+    std::vector<ScanRecord> expectedTop = {record("TSLA", 7.25), record("NVDA", 7.25), record("AAPL", 2.5)};
+    std::vector<ScanRecord> expectedBottom = {record("META", -3.0), record("MSFT", -1.0)};
+    EXPECT_EQ(topK(records, 3), expectedTop);
+    EXPECT_EQ(bottomK(records, 2), expectedBottom);
+
+    TopKSelector<ScanRecord, MetricLess> top(3);
+    top.pushRange(records.begin(), records.end());
+    EXPECT_EQ(top.results(), expectedTop);
+
+    TopKSelector<ScanRecord, MetricGreater> bottom(2);
+    bottom.pushRange(records.begin(), records.end());
+    EXPECT_EQ(bottom.results(), expectedBottom);
+    EXPECT_EQ(symbols.name(top.results().front().symbol), "TSLA");
+}
+
+TEST(TopKTests, EdgeCases) {
+    std::vector<ScanRecord> records = {{0, 1.0}, {1, 2.0}};
+
+    EXPECT_TRUE(topK(records, 0).empty());
+    EXPECT_TRUE(topK({}, 5).empty());
+    EXPECT_EQ(topK(records, 5).size(), 2u); // k larger than the input returns everything, ranked
+
+    TopKSelector<ScanRecord, MetricLess> none(0);
+    none.pushRange(records.begin(), records.end());
+    EXPECT_TRUE(none.empty());
+
+    TopKSelector<ScanRecord, MetricLess> partial(5);
+    partial.pushRange(records.begin(), records.end());
+    EXPECT_EQ(partial.results(), std::vector<ScanRecord>({{1, 2.0}, {0, 1.0}}));
+}
+
+TEST(TopKTests, MatchesFullSortOnLargeUniverse) {
+    std::mt19937 gen(34);
+    std::normal_distribution<> moves(0.0, 3.0);
+    std::vector<ScanRecord> records;
+    for (SymbolId id = 0; id < 10000; ++id) {
+        records.push_back({id, moves(gen)});
+    }
+
+    std::vector<ScanRecord> sorted = records;
+    std::sort(sorted.begin(), sorted.end(), MetricLess());
+    std::vector<ScanRecord> expectedBottom(sorted.begin(), sorted.begin() + 50);
+    std::vector<ScanRecord> expectedTop(sorted.rbegin(), sorted.rbegin() + 50);
+
+    TopKSelector<ScanRecord, MetricLess> streaming(50);
+    for (const auto& record : records) streaming.push(record);
+
+    EXPECT_EQ(streaming.results(), expectedTop);
+    EXPECT_EQ(topK(records, 50), expectedTop);
+    EXPECT_EQ(bottomK(records, 50), expectedBottom);
+}
+
+// Symbol table tests
+TEST(SymbolTableTests, InternsDenseIds) {
+    SymbolTable symbols;
+    EXPECT_TRUE(symbols.empty());
+    EXPECT_EQ(symbols.intern("AAPL"), 0u);
+    EXPECT_EQ(symbols.intern(std::string("MSFT")), 1u);
+    EXPECT_EQ(symbols.intern("AAPL"), 0u);
+
+    // A view into a larger buffer finds the symbol without copying it out
+    std::string_view line = "MSFT,2024-11-01,415.25";
+    EXPECT_EQ(symbols.find(line.substr(0, 4)), std::optional<SymbolId>(1));
+    EXPECT_FALSE(symbols.find("TSLA").has_value());
+    EXPECT_EQ(symbols.size(), 2u);
+
+    const std::string& first = symbols.name(0);
+    for (int i = 0; i < 1000; ++i) {
+        symbols.intern("T" + std::to_string(i));
+    }
+    EXPECT_EQ(first, "AAPL"); // Names keep their address as the table grows
+    EXPECT_EQ(symbols.name(1001), "T999");
+    EXPECT_THROW(symbols.name(1002), std::out_of_range);
+}
+
+// K-way merge tests
+TEST(KWayMergeTests, MergesManySortedSeries) {
+    std::mt19937 gen(35);
+    std::uniform_int_distribution<int> length(0, 40);
+    std::uniform_int_distribution<int64_t> step(0, 3);
+
+    // 1000 tickers of bars on a shared clock, some empty, many sharing timestamps
+    std::vector<std::vector<PriceBar>> series(1000);
+    for (size_t ticker = 0; ticker < series.size(); ++ticker) {
+        int64_t timestamp = 1730453400;
+        for (int i = length(gen); i > 0; --i) {
+            timestamp += 60 * step(gen);
+            series[ticker].push_back({timestamp, static_cast<double>(ticker)});
+        }
+    }
+
+    std::vector<PriceBar> expected;
+    for (const auto& bars : series) expected.insert(expected.end(), bars.begin(), bars.end());
+    std::stable_sort(expected.begin(), expected.end(), PriceBarTimeLess());
+
+    // Equal timestamps come out in ticker order, exactly like the stable sort
+    std::vector<PriceBar> merged = kWayMerge(series, PriceBarTimeLess());
+    ASSERT_EQ(merged.size(), expected.size());
+    for (size_t i = 0; i < merged.size(); ++i) {
+        EXPECT_EQ(merged[i].timestamp, expected[i].timestamp);
+        EXPECT_EQ(merged[i].close, expected[i].close);
+    }
+
+    KWayMerger<PriceBar, PriceBarTimeLess> merger(series);
+    PriceBar bar{};
+    size_t source = 0;
+    size_t count = 0;
+    while (merger.next(bar, source)) {
+        EXPECT_EQ(static_cast<double>(source), bar.close);
+        ++count;
+    }
+    EXPECT_EQ(count, expected.size());
+}
+
+TEST(KWayMergeTests, EdgeCases) {
+    EXPECT_TRUE(kWayMerge(std::vector<std::vector<double>>{}).empty());
+    EXPECT_TRUE(kWayMerge(std::vector<std::vector<double>>{{}, {}, {}}).empty());
+    EXPECT_EQ(kWayMerge(std::vector<std::vector<double>>{{1.0, 2.0, 3.0}}), (std::vector<double>{1.0, 2.0, 3.0}));
+    EXPECT_EQ(kWayMerge(std::vector<std::vector<double>>{{5.0}, {}, {1.0, 5.0}, {2.0}, {0.5, 9.0}}),
+              (std::vector<double>{0.5, 1.0, 2.0, 5.0, 5.0, 9.0}));
+
+    std::vector<std::vector<double>> emptySources(3);
+    KWayMerger<double> empty(emptySources);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_THROW(empty.top(), std::out_of_range);
+    EXPECT_THROW(empty.pop(), std::out_of_range);
+}
+
+TEST(SortingTests, AdaptiveMergeSortCorrectness) {
+    std::vector<double> data = {5.0, 3.0, 8.0, 6.0, 2.0};
+    adaptiveMergeSort(data);
+    EXPECT_TRUE(isSorted(data));
+}
+
+TEST(SortingTests, AdaptiveMergeSortEdgeCases) {
+    std::vector<double> emptyData;
+    adaptiveMergeSort(emptyData);
+    EXPECT_TRUE(emptyData.empty());
+
+    std::vector<double> singleElement = {1.0};
+    adaptiveMergeSort(singleElement);
+    EXPECT_EQ(singleElement, std::vector<double>({1.0}));
+
+    std::vector<double> duplicates = {5.0, 1.0, 5.0, 3.0, 1.0};
+    adaptiveMergeSort(duplicates);
+    EXPECT_TRUE(isSorted(duplicates));
+}
+
+TEST(SortingTests, AdaptiveMergeSortMatchesStdSortOnEveryShape) {
+    std::mt19937 gen(36);
+    for (InputShape shape : allInputShapes()) {
+        for (size_t size : {31, 33, 1000, 65537, 200000}) {
+            std::vector<double> data = generateSortInput(shape, size, gen, {3.0, 1.0, 2.0, 2.0, 5.0});
+            std::vector<double> expected = data;
+            std::sort(expected.begin(), expected.end());
+
+            adaptiveMergeSort(data);
+            EXPECT_EQ(data, expected) << inputShapeName(shape) << " " << size;
+        }
+    }
+
+    // Runs that alternate direction and interleave, which forces long galloping merges
+    std::vector<double> organPipe;
+    for (int block = 0; block < 50; ++block) {
+        for (int i = 0; i < 1000; ++i) organPipe.push_back(block % 2 ? 1000.0 - i : i + block * 0.5);
+    }
+    std::vector<double> expected = organPipe;
+    std::sort(expected.begin(), expected.end());
+    adaptiveMergeSort(organPipe);
+    EXPECT_EQ(organPipe, expected);
+}
+
+TEST(SortingTests, AdaptiveMergeSortIsStable) {
+    // -0.0 and 0.0 compare equal, so their signs show whether equal elements kept their order
+    std::vector<double> data;
+    std::vector<bool> expectedSigns;
+    std::mt19937 gen(37);
+    std::uniform_int_distribution<int> pick(0, 2);
+    for (int i = 0; i < 5000; ++i) {
+        int choice = pick(gen);
+        if (choice == 2) {
+            data.push_back(i % 3 - 1.5);
+        } else {
+            data.push_back(choice ? -0.0 : 0.0);
+            expectedSigns.push_back(choice == 1);
+        }
+    }
+
+    adaptiveMergeSort(data);
+    ASSERT_TRUE(isSorted(data));
+    std::vector<bool> signs;
+    for (double value : data) {
+        if (value == 0.0) signs.push_back(std::signbit(value));
+    }
+    EXPECT_EQ(signs, expectedSigns);
+}
+
+TEST(SortingTests, SimdSortCorrectness) {
+    std::vector<double> data = {5.0, 3.0, 8.0, 6.0, 2.0};
+    simdSort(data);
+    EXPECT_TRUE(isSorted(data));
+}
+
+TEST(SortingTests, SimdSortEdgeCases) {
+    std::vector<double> emptyData;
+    simdSort(emptyData);
+    EXPECT_TRUE(emptyData.empty());
+
+    std::vector<double> singleElement = {1.0};
+    simdSort(singleElement);
+    EXPECT_EQ(singleElement, std::vector<double>({1.0}));
+
+    std::vector<double> duplicates = {5.0, 1.0, 5.0, 3.0, 1.0};
+    simdSort(duplicates);
+    EXPECT_TRUE(isSorted(duplicates));
+
+    const double infinity = std::numeric_limits<double>::infinity();
+    std::vector<double> extremes = {infinity, -0.0, -infinity, 1e308, 0.0, -1e-308, infinity};
+    std::vector<double> expected = extremes;
+    std::sort(expected.begin(), expected.end());
+    simdSort(extremes);
+    EXPECT_EQ(extremes, expected);
+}
+
+TEST(SortingTests, SimdSortMatchesStdSortAtEveryLevel) {
+    // Runs every level up to the widest this machine supports
+    std::mt19937 gen(37);
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > detectedSimdLevel()) break;
+
+        for (InputShape shape : allInputShapes()) {
+            for (size_t size : {2, 3, 7, 16, 31, 32, 33, 64, 65, 100, 1000, 65537, 300000}) {
+                std::vector<double> data = generateSortInput(shape, size, gen, {3.0, 1.0, 2.0, 2.0, 5.0});
+                std::vector<double> expected = data;
+                std::sort(expected.begin(), expected.end());
+
+                simdSort(data, level);
+                EXPECT_EQ(data, expected) << simdLevelName(level) << " " << inputShapeName(shape) << " " << size;
+            }
+        }
+    }
+}
+
+TEST(SortingTests, SimdSortSmallSortsEveryBlockSize) {
+    std::mt19937 gen(38);
+    std::uniform_real_distribution<> dis(-50.0, 50.0);
+    for (size_t size = 0; size <= 100; ++size) {
+        std::vector<double> window(size);
+        std::generate(window.begin(), window.end(), [&]() { return dis(gen); });
+        std::vector<double> expected = window;
+        std::sort(expected.begin(), expected.end());
+
+        simdSortSmall(window.data(), window.size());
+        EXPECT_EQ(window, expected) << size;
+    }
+}